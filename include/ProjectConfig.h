@@ -29,6 +29,9 @@
 #define SD_CS_PIN 5     // Chip Select for SD Card module (HW-203)
 #define ADC1_CS_PIN 4     // Chip Select for ADS1118 #1 (3.3V bus & pH)
 #define ADC2_CS_PIN 2     // Chip Select for ADS1118 #2 (5V bus & EC)
+// The ADS1118 signals DRDY on DOUT, so it is read on the shared MISO line
+// while the ADC's chip select is low.
+#define ADC_DRDY_PIN VSPI_MISO_PIN
 
 // --- 1-Wire & Proprietary Buses ---
 #define ONE_WIRE_BUS_PIN 15 // For DS18B20 temperature sensor(s)
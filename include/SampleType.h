@@ -0,0 +1,33 @@
+// File Path: /include/SampleType.h
+// MODIFIED FILE
+
+#ifndef SAMPLE_TYPE_H
+#define SAMPLE_TYPE_H
+
+// =================================================================
+// Measurement Pipeline Precision
+// =================================================================
+// The ESP32's FPU is single-precision only; every 'double' operation is
+// emulated in software. Building with -DPIPELINE_FLOAT_PRECISION=1 (see the
+// esp32dev_float environment in platformio.ini) runs the filter, calibration
+// and analysis math in hardware 'float' instead. The accuracy cost of this
+// mode is documented in Filter_Pipeline.md.
+
+#ifndef PIPELINE_FLOAT_PRECISION
+#define PIPELINE_FLOAT_PRECISION 0
+#endif
+
+#if PIPELINE_FLOAT_PRECISION == 1
+typedef float sample_t;
+#else
+typedef double sample_t;
+#endif
+
+// Building with -DPIPELINE_FIXED_POINT=1 (see esp32dev_fixed) routes the live
+// measurement path through the integer filters, which work directly on ADC
+// counts and convert to millivolts only at the calibration boundary.
+#ifndef PIPELINE_FIXED_POINT
+#define PIPELINE_FIXED_POINT 0
+#endif
+
+#endif // SAMPLE_TYPE_H
@@ -3,6 +3,10 @@
 
 #include "ADS1118.h"
 #include "Arduino.h"
+#if defined(ESP32)
+#include "freertos/semphr.h"
+#include "driver/gpio.h"
+#endif
 
 #if defined(__AVR__)
 ADS1118::ADS1118(uint8_t io_pin_cs) {
@@ -24,7 +28,13 @@ void ADS1118::begin() {
     configRegister.bits={RESERVED, VALID_CFG, DOUT_PULLUP, ADC_MODE, RATE_8SPS, SINGLE_SHOT, FSR_0256, DIFF_0_1, START_NOW};
 }
 #elif defined(ESP32)
+// --- NEW: Given by the DRDY interrupt, taken in waitDataReady(). One for
+// all chips: they share the DRDY line, and the bus is waited on by one
+// task at a time. ---
+static SemaphoreHandle_t drdySignal = nullptr;
+
 void ADS1118::begin() {
+    if (!drdySignal) drdySignal = xSemaphoreCreateBinary();
     pinMode(cs, OUTPUT);
     digitalWrite(cs, HIGH);
     // pSpi->begin(); // <<< CRITICAL FIX: DO NOT re-initialize the bus. The main app is responsible for this.
@@ -32,6 +42,7 @@ void ADS1118::begin() {
 }
 
 void ADS1118::begin(uint8_t sclk, uint8_t miso, uint8_t mosi) {
+    if (!drdySignal) drdySignal = xSemaphoreCreateBinary();
     pinMode(cs, OUTPUT);
 	digitalWrite(cs, HIGH);
     pSpi->begin(sclk, miso, mosi, cs);
@@ -57,6 +68,150 @@ bool ADS1118::getADCValueNoWait(uint8_t pin_drdy, uint16_t &value) {
     return true;
 }
 
+// --- NEW: DRDY-paced continuous-mode reads ---
+
+// The pin the DRDY interrupt is attached to, 0xFF before the first wait.
+static uint8_t drdyPin = 0xFF;
+
+static void IRAM_ATTR onDataReady() {
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(drdySignal, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+// Blocks until DOUT/DRDY is low, with CS already low. The line is shared
+// MISO and toggles with every other transfer on the bus, so its interrupt is
+// only enabled for the wait. It is attached once, on the first wait: after
+// that, arming it is a register write rather than a handler install. The
+// edge wakes the waiter through a semaphore of its own, never the task
+// notification, which callers such as the acquisition task use for their
+// own timing; and the pin decides, not the wake-up.
+bool ADS1118::waitDataReady(uint8_t pin_drdy, uint32_t timeoutMs) {
+    if (!digitalRead(pin_drdy)) return true;
+    if (!drdySignal) return false;
+    // An edge left over from an earlier wait, or from SD traffic latched
+    // while the interrupt was disabled.
+    xSemaphoreTake(drdySignal, 0);
+    if (drdyPin != pin_drdy) {
+        if (drdyPin != 0xFF) detachInterrupt(digitalPinToInterrupt(drdyPin));
+        attachInterrupt(digitalPinToInterrupt(pin_drdy), onDataReady, FALLING);
+        drdyPin = pin_drdy;
+    } else {
+        gpio_intr_enable((gpio_num_t)pin_drdy);
+    }
+    uint32_t start = millis();
+    // The edge may have come before the interrupt was armed.
+    bool ready = !digitalRead(pin_drdy);
+    while (!ready) {
+        uint32_t elapsed = millis() - start;
+        if (elapsed >= timeoutMs) break;
+        TickType_t wait = pdMS_TO_TICKS(timeoutMs - elapsed);
+        xSemaphoreTake(drdySignal, (wait > 0) ? wait : 1);
+        ready = !digitalRead(pin_drdy);
+    }
+    gpio_intr_disable((gpio_num_t)pin_drdy);
+    return ready;
+}
+
+// One new conversion from a chip in continuous mode: wait for DRDY, then a
+// single 32-bit transfer returns the result and reads back the config.
+// If the config has to change, the conversion in progress still uses the
+// old one and is dropped.
+bool ADS1118::getCountsContinuous(uint8_t pin_drdy, uint8_t inputs, int16_t &counts) {
+    configRegister.bits.sensorMode=ADC_MODE;
+    configRegister.bits.mux=inputs;
+    configRegister.bits.operatingMode=CONTINUOUS;
+    // Timeout: two conversion times and a tick to spare.
+    uint32_t timeoutMs = 2 * CONV_TIME[configRegister.bits.rate] + 2;
+    bool reconfigure = (chipConfig != configRegister.word);
+    Config readOnly = configRegister;
+    readOnly.bits.noOperation = NO_VALID_CFG;
+    uint16_t din = reconfigure ? configRegister.word : readOnly.word;
+
+    digitalWrite(cs, LOW);
+    if (!reconfigure && !waitDataReady(pin_drdy, timeoutMs)) {
+        digitalWrite(cs, HIGH);
+        return false;
+    }
+    uint32_t frame = pSpi->transfer32(((uint32_t)din << 16) | din);
+    if (reconfigure) {
+        chipConfig = configRegister.word;
+        // Drop the conversion that was under way, then take the next.
+        if (!waitDataReady(pin_drdy, timeoutMs)) { digitalWrite(cs, HIGH); return false; }
+        pSpi->transfer32(((uint32_t)readOnly.word << 16) | readOnly.word);
+        if (!waitDataReady(pin_drdy, timeoutMs)) { digitalWrite(cs, HIGH); return false; }
+        frame = pSpi->transfer32(((uint32_t)readOnly.word << 16) | readOnly.word);
+    }
+    digitalWrite(cs, HIGH);
+
+    // Compare the settings that matter; the NOP, reserved and start bits
+    // do not read back as written.
+    const uint16_t settingsMask = 0x7FF8;
+    if (((uint16_t)frame & settingsMask) != (configRegister.word & settingsMask)) {
+        chipConfig = 0;
+        return false;
+    }
+    counts = (int16_t)(frame >> 16);
+    return true;
+}
+
+// Ends a run of getCountsContinuous() reads without dropping a conversion.
+// Single-shot mode is written at once, with no start; the conversion already
+// under way keeps its settings, is the last before the chip powers down, and
+// is returned. The chip is then as the ConversionScheduler expects it.
+bool ADS1118::stopContinuous(uint8_t pin_drdy, int16_t &counts) {
+    configRegister.bits.operatingMode=SINGLE_SHOT;
+    uint32_t timeoutMs = 2 * CONV_TIME[configRegister.bits.rate] + 2;
+    Config stop = configRegister;
+    stop.bits.singleStart = 0;
+    Config readOnly = stop;
+    readOnly.bits.noOperation = NO_VALID_CFG;
+
+    digitalWrite(cs, LOW);
+    pSpi->transfer32(((uint32_t)stop.word << 16) | stop.word);
+    chipConfig = stop.word;
+    if (!waitDataReady(pin_drdy, timeoutMs)) {
+        digitalWrite(cs, HIGH);
+        chipConfig = 0;
+        return false;
+    }
+    uint32_t frame = pSpi->transfer32(((uint32_t)readOnly.word << 16) | readOnly.word);
+    digitalWrite(cs, HIGH);
+
+    const uint16_t settingsMask = 0x7FF8;
+    if (((uint16_t)frame & settingsMask) != (stop.word & settingsMask)) {
+        chipConfig = 0;
+        return false;
+    }
+    counts = (int16_t)(frame >> 16);
+    return true;
+}
+
+void ADS1118::select() {
+    digitalWrite(cs, LOW);
+}
+
+void ADS1118::deselect() {
+    digitalWrite(cs, HIGH);
+}
+
+// One 32-bit frame with CS already low: the result and the readback of
+// 'config'. A word with NOP = 00 is not written and leaves chipConfig alone.
+uint32_t ADS1118::exchange(uint16_t config) {
+    uint32_t frame = pSpi->transfer32(((uint32_t)config << 16) | config);
+    Config written;
+    written.word = config;
+    if (written.bits.noOperation == VALID_CFG) chipConfig = config;
+    return frame;
+}
+
+// waitDataReady() with the timeout of the conversion last started.
+bool ADS1118::waitConversion(uint8_t pin_drdy) {
+    Config written;
+    written.word = chipConfig;
+    return waitDataReady(pin_drdy, 2 * CONV_TIME[written.bits.rate] + 2);
+}
+
 bool ADS1118::getMilliVoltsNoWait(uint8_t pin_drdy, double &volts) {
     float fsr = pgaFSR[configRegister.bits.pga];
 	uint16_t value;
@@ -93,6 +248,7 @@ uint16_t ADS1118::getADCValue(uint8_t inputs) {
         configLSB = pSpi->transfer(configRegister.byte.lsb);
 
 	    digitalWrite(cs, HIGH);
+	    chipConfig=configRegister.word;
 
 	    for(int i=0;i<CONV_TIME[configRegister.bits.rate];i++)
             delayMicroseconds(1000);
@@ -116,6 +272,16 @@ double ADS1118::getMilliVolts(uint8_t inputs) {
     return volts*1000;
 }
 
+// Raw signed conversion result, for callers that work in counts.
+int16_t ADS1118::getCounts(uint8_t inputs) {
+    return (int16_t)getADCValue(inputs);
+}
+
+// Size of one count at the current full scale range.
+double ADS1118::getMilliVoltsPerCount() {
+    return pgaFSR[configRegister.bits.pga] * 1000.0 / 32768;
+}
+
 double ADS1118::getMilliVolts() {
     float volts;
     float fsr = pgaFSR[configRegister.bits.pga];
@@ -145,6 +311,7 @@ double ADS1118::getTemperature() {
         configMSB = pSpi->transfer(configRegister.byte.msb);
         configLSB = pSpi->transfer(configRegister.byte.lsb);
         digitalWrite(cs, HIGH);
+        chipConfig=configRegister.word;
 
 	    for(int i=0;i<CONV_TIME[configRegister.bits.rate];i++)
             delayMicroseconds(1000);
@@ -49,6 +49,24 @@ class ADS1118 {
 	void disablePullup();
 	void enablePullup();
 	void setInputSelected(uint8_t input);
+	int16_t getCounts(uint8_t inputs);
+	double getMilliVoltsPerCount();
+#if defined(ESP32)
+	// --- NEW: Continuous-mode reads paced by DOUT/DRDY. The caller owns
+	// the bus, as for getCounts(). ---
+	bool waitDataReady(uint8_t pin_drdy, uint32_t timeoutMs);
+	bool getCountsContinuous(uint8_t pin_drdy, uint8_t inputs, int16_t &counts);
+	// --- NEW: The last conversion of a continuous run, after which the
+	// chip is back in single-shot mode and powered down. ---
+	bool stopContinuous(uint8_t pin_drdy, int16_t &counts);
+	// --- NEW: Frame-level access for the ConversionScheduler, which
+	// interleaves conversions on several chips. The caller owns the bus. ---
+	void select();
+	void deselect();
+	uint32_t exchange(uint16_t config);
+	bool waitConversion(uint8_t pin_drdy);
+	uint16_t getWrittenConfig() const { return chipConfig; }
+#endif
 
     // --- All constants are now static ---
 	static const uint8_t DIFF_0_1 	  = 0b000;
@@ -92,6 +110,8 @@ private:
 	SPIClass *pSpi;
 #endif  
 	uint8_t lastSensorMode=3;
+	// The config last written to the chip, 0 if unknown.
+	uint16_t chipConfig=0;
     uint8_t cs;
 	const float pgaFSR[8] = {6.144, 4.096, 2.048, 1.024, 0.512, 0.256, 0.256, 0.256};
 	const uint8_t CONV_TIME[8]={125, 63, 32, 16, 8, 4, 3, 2};
@@ -0,0 +1,195 @@
+// File Path: /lib/AcquisitionManager/src/AcquisitionManager.cpp
+// NEW FILE
+
+#include "AcquisitionManager.h"
+
+AcquisitionManager::AcquisitionManager() :
+    _adc(nullptr),
+    _task(nullptr),
+    _timer(nullptr),
+    _periodUs(ACQ_DEFAULT_PERIOD_US),
+    _failedReads(0)
+{
+    // The default scan, in ACQ_CH_* order: each chip has three conversions
+    // at most, so a full pass is about three conversion times.
+    _scan.add({0, ADS1118::DIFF_0_1, ADS1118::FSR_4096, ADS1118::RATE_860SPS, false});
+    _scan.add({1, ADS1118::DIFF_0_1, ADS1118::FSR_4096, ADS1118::RATE_860SPS, false});
+    _scan.add({0, ADS1118::AIN_2, ADS1118::FSR_4096, ADS1118::RATE_860SPS, false});
+    _scan.add({1, ADS1118::AIN_2, ADS1118::FSR_4096, ADS1118::RATE_860SPS, false});
+    _scan.add({1, ADS1118::DIFF_0_1, ADS1118::FSR_4096, ADS1118::RATE_860SPS, true});
+    setScanList(_scan);
+}
+
+void AcquisitionManager::setScanList(const ScanList& scan) {
+    _scan = scan;
+    for (size_t c = 0; c < SCAN_MAX_CHANNELS; ++c) {
+        uint8_t mux = (c < _scan.size()) ? _scan.channel(c).mux : 0;
+        _requests[c].store(mux, std::memory_order_relaxed);
+        _generations[c] = 0;
+    }
+}
+
+bool AcquisitionManager::begin(AdcManager& adcManager, uint32_t periodUs) {
+    _adc = &adcManager;
+    _periodUs = (periodUs > 0) ? periodUs : ACQ_DEFAULT_PERIOD_US;
+    if (xTaskCreatePinnedToCore(taskEntry, "acqTask", 3072, this, ACQ_TASK_PRIORITY, &_task, 0) != pdPASS) {
+        return false;
+    }
+    esp_timer_create_args_t args = {};
+    args.callback = onTimer;
+    args.arg = this;
+    args.name = "acq";
+    if (esp_timer_create(&args, &_timer) != ESP_OK) return false;
+    return esp_timer_start_periodic(_timer, _periodUs) == ESP_OK;
+}
+
+void AcquisitionManager::setPeriod(uint32_t periodUs) {
+    if (periodUs == 0 || periodUs == _periodUs) return;
+    _periodUs = periodUs;
+    if (_timer) {
+        esp_timer_stop(_timer);
+        esp_timer_start_periodic(_timer, _periodUs);
+    }
+}
+
+void AcquisitionManager::setInput(uint8_t channel, uint8_t inputs) {
+    if (channel >= _scan.size()) return;
+    // The UI and data tasks may both switch inputs.
+    uint16_t request = _requests[channel].load(std::memory_order_relaxed);
+    uint16_t next;
+    do {
+        if ((request & 0xFF) == inputs) return;
+        next = (uint16_t)((((request >> 8) + 1) & 0xFF) << 8 | inputs);
+    } while (!_requests[channel].compare_exchange_weak(request, next, std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool AcquisitionManager::isCurrent(const SampleRecord& record) const {
+    if (record.channel >= _scan.size()) return false;
+    return (_requests[record.channel].load(std::memory_order_acquire) >> 8) == record.generation;
+}
+
+// Acquisition task: takes up the inputs posted by setInput().
+void AcquisitionManager::applyRequests() {
+    for (size_t c = 0; c < _scan.size(); ++c) {
+        uint16_t request = _requests[c].load(std::memory_order_acquire);
+        uint8_t generation = (uint8_t)(request >> 8);
+        if (generation == _generations[c]) continue;
+        _scan.setMux(c, (uint8_t)(request & 0xFF));
+        _generations[c] = generation;
+    }
+}
+
+int AcquisitionManager::findChannel(uint8_t adcIndex, uint8_t inputs) const {
+    // From the end, so a channel converted on every tick is preferred to a
+    // probe channel that was switched to the same input.
+    for (size_t c = _scan.size(); c-- > 0;) {
+        const ScanChannel& channel = _scan.channel(c);
+        if (channel.chip == adcIndex && getInput((uint8_t)c) == inputs && !channel.temperature) return (int)c;
+    }
+    return -1;
+}
+
+// Runs in the esp_timer task: only wakes the acquisition task. The task
+// notification is the tick's alone; DRDY waits have a semaphore of their own.
+void AcquisitionManager::onTimer(void* arg) {
+    AcquisitionManager* self = static_cast<AcquisitionManager*>(arg);
+    xTaskNotifyGive(self->_task);
+}
+
+void AcquisitionManager::taskEntry(void* arg) {
+    static_cast<AcquisitionManager*>(arg)->run();
+}
+
+/**
+ * @brief One pass of the scan per timer tick, the channels converted
+ * together and stamped with the time the pass ended. A tick that comes
+ * while the previous pass is still waiting on the SPI bus (an SD write, a
+ * priming burst) is folded into it rather than queued, so the timestamps
+ * show the gap. Input switches are taken up between passes, so a pass
+ * never sees half of one.
+ */
+void AcquisitionManager::run() {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        applyRequests();
+        // --- NEW: The precomputed words of every channel due this tick. ---
+        const ConversionSlot* scan = _scan.slots();
+        ConversionSlot slots[SCAN_MAX_CHANNELS];
+        uint8_t channels[SCAN_MAX_CHANNELS];
+        size_t count = 0;
+        for (size_t c = 0; c < _scan.size(); ++c) {
+            if (c < ACQ_PROBE_CHANNELS && !_adc->isProbeActive(c)) continue;
+            slots[count] = scan[c];
+            channels[count++] = (uint8_t)c;
+        }
+        if (count == 0) continue;
+        int16_t counts[SCAN_MAX_CHANNELS];
+        bool ok[SCAN_MAX_CHANNELS];
+        _adc->convert(slots, count, counts, ok);
+        uint32_t now = (uint32_t)esp_timer_get_time();
+        for (size_t i = 0; i < count; ++i) {
+            if (!ok[i]) {
+                _failedReads++;
+                continue;
+            }
+            SampleRecord record;
+            record.timestampUs = now;
+            record.channel = channels[i];
+            record.generation = _generations[channels[i]];
+            record.rawCount = counts[i];
+            _bus.publish(record);
+        }
+    }
+}
+
+SampleCursor AcquisitionManager::subscribe() const {
+    SampleCursor cursor;
+    _bus.attach(cursor);
+    return cursor;
+}
+
+size_t AcquisitionManager::read(SampleCursor& cursor, uint8_t channel, sample_t* voltages, size_t max, uint32_t* timestamps) {
+    size_t written = 0;
+    while (written < max) {
+        const SampleRecord* records;
+        size_t available = _bus.peek(cursor, records);
+        // Scans up to the first record of this channel there is no room for.
+        size_t scanned = 0, kept = 0;
+        while (scanned < available && written + kept < max) {
+            const SampleRecord& record = records[scanned++];
+            if (record.channel != channel || !isCurrent(record)) continue;
+            voltages[written + kept] = toMilliVolts(record);
+            if (timestamps) timestamps[written + kept] = record.timestampUs;
+            kept++;
+        }
+        if (scanned == 0) break;
+        // Overwritten while being converted: dropped.
+        if (_bus.consume(cursor, scanned)) written += kept;
+    }
+    return written;
+}
+
+double AcquisitionManager::measuredRate(const uint32_t* timestamps, size_t count) const {
+    if (count < 2) return getSampleRate();
+    // Unsigned, so a wrap of the microsecond clock cancels out.
+    uint32_t elapsed = timestamps[count - 1] - timestamps[0];
+    return (elapsed > 0) ? (count - 1) * 1e6 / elapsed : getSampleRate();
+}
+
+// --- NEW: From the channel's own range, and the divider on the input it
+// was last switched to; records taken before the switch are not current. ---
+double AcquisitionManager::scaleOf(uint8_t channel) const {
+    if (channel >= _scan.size()) return 0.0;
+    const ScanChannel& input = _scan.channel(channel);
+    double scale = _scan.unitsPerCount(channel);
+    if (!input.temperature) scale *= AdcManager::getInputDivider(getInput(channel));
+    return scale;
+}
+
+float AcquisitionManager::getMilliVoltsPerCount(uint8_t channel) {
+    return (float)scaleOf(channel);
+}
+
+sample_t AcquisitionManager::toMilliVolts(const SampleRecord& record) {
+    return record.rawCount * (sample_t)scaleOf(record.channel);
+}
@@ -0,0 +1,153 @@
+// File Path: /lib/AcquisitionManager/src/AcquisitionManager.h
+// NEW FILE
+
+#ifndef ACQUISITION_MANAGER_H
+#define ACQUISITION_MANAGER_H
+
+#include <AdcManager.h>
+#include <ScanList.h>
+#include "SampleBus.h"
+#include "SampleType.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include <atomic>
+
+// The filters, predictors and FFTs are tuned for one sample per 22 ms.
+#define ACQ_DEFAULT_PERIOD_US 22000
+// 8 KB. A consumer may fall half of it behind, about 2.2 s of the full
+// default scan, before it starts losing samples.
+#define ACQ_BUS_SIZE 1024
+// Above the data (2) and UI (3) tasks, so samples are taken on time.
+#define ACQ_TASK_PRIORITY 5
+// --- NEW: The default scan's channels. A probe's channel is its ADC index;
+// channels below ACQ_PROBE_CHANNELS are only converted while their probe
+// is active, the rest on every tick. ---
+#define ACQ_PROBE_CHANNELS 2
+#define ACQ_CH_PH          0
+#define ACQ_CH_EC          1
+#define ACQ_CH_RAIL_3V3    2
+#define ACQ_CH_RAIL_5V     3
+#define ACQ_CH_TEMPERATURE 4
+// Samples a consumer takes per pass, at most: a few ticks' worth, so it
+// catches up after a slow pass without a long stall.
+#define ACQ_DRAIN_BATCH 32
+
+/**
+ * @class AcquisitionManager
+ * @brief --- NEW: Samples the active probes at an exact rate on a task of
+ * its own. ---
+ *
+ * A periodic esp_timer wakes the acquisition task, which converts its scan
+ * list in one interleaved pass (AdcManager::convert) and publishes a
+ * timestamped SampleRecord per channel on a SampleBus. The sample period
+ * therefore no longer depends on how long the data task spends filtering,
+ * drawing or writing to the SD card.
+ *
+ * --- NEW: Each consumer subscribes a SampleCursor of its own, so the
+ * filters, the captures and the live voltmeter all see the same
+ * conversions. A consumer that falls behind loses the oldest samples
+ * (counted in its cursor) and never holds up the acquisition task. ---
+ *
+ * --- NEW: What is converted is a ScanList, its config words built once.
+ * The default scan is pH and EC (DIFF_0_1 on ADC 0 and 1, while active),
+ * the 3.3 V and 5 V rails (AIN_2 on ADC 0 and 1) and ADC 1's temperature
+ * sensor, all at 860 SPS on the 4.096 V range. ---
+ */
+class AcquisitionManager {
+public:
+    AcquisitionManager();
+
+    bool begin(AdcManager& adcManager, uint32_t periodUs = ACQ_DEFAULT_PERIOD_US);
+
+    /**
+     * @brief --- NEW: Replaces the default scan. Call before begin(); a
+     * record's channel is the index in this list. ---
+     */
+    void setScanList(const ScanList& scan);
+    const ScanList& getScanList() const { return _scan; }
+
+    void setPeriod(uint32_t periodUs);
+    uint32_t getPeriodUs() const { return _periodUs; }
+    double getSampleRate() const { return 1e6 / _periodUs; }
+
+    /**
+     * @brief Switches a channel to another input of its ADC. Safe from any
+     * task. --- NEW: The switch is posted to the acquisition task, which
+     * applies it at the start of its next pass; until then, and for records
+     * already on the bus, isCurrent() is false. ---
+     */
+    void setInput(uint8_t channel, uint8_t inputs);
+    uint8_t getInput(uint8_t channel) const { return _requests[channel].load(std::memory_order_relaxed) & 0xFF; }
+
+    /**
+     * @brief --- NEW: False for a record taken on the input a channel had
+     * before its last setInput(). read() drops these; in-place readers
+     * should too. ---
+     */
+    bool isCurrent(const SampleRecord& record) const;
+
+    /**
+     * @brief --- NEW: The channel that converts an ADC input, -1 if none
+     * does. ---
+     */
+    int findChannel(uint8_t adcIndex, uint8_t inputs) const;
+
+    // --- Consumer side; each cursor belongs to one task ---
+
+    // A cursor that starts at the next sample taken.
+    SampleCursor subscribe() const;
+
+    // Drops everything queued for one consumer, e.g. when its screen changes.
+    void flush(SampleCursor& cursor) const { _bus.skip(cursor); }
+
+    /**
+     * @brief The oldest unread records, in place (see SampleBus::peek).
+     * Follow with consume().
+     */
+    size_t peek(SampleCursor& cursor, const SampleRecord*& records) { return _bus.peek(cursor, records); }
+    bool consume(SampleCursor& cursor, size_t count) { return _bus.consume(cursor, count); }
+
+    /**
+     * @brief Copies out up to 'max' of one channel's unread samples, in
+     * millivolts (degrees Celsius for a temperature channel). Other
+     * channels' records are passed over.
+     * @return The number written to 'voltages' and, if given, 'timestamps'.
+     */
+    size_t read(SampleCursor& cursor, uint8_t channel, sample_t* voltages, size_t max, uint32_t* timestamps = nullptr);
+
+    /**
+     * @brief The rate a run of samples was actually taken at, in Hz, from
+     * their timestamps; getSampleRate() if there are too few to tell.
+     */
+    double measuredRate(const uint32_t* timestamps, size_t count) const;
+
+    sample_t toMilliVolts(const SampleRecord& record);
+    float getMilliVoltsPerCount(uint8_t channel);
+
+    // Reads that timed out. Lost samples are counted per consumer, in its cursor.
+    uint32_t getFailedReadCount() const { return _failedReads; }
+
+private:
+    static void taskEntry(void* arg);
+    static void onTimer(void* arg);
+    void run();
+    void applyRequests();
+    double scaleOf(uint8_t channel) const;
+
+    AdcManager* _adc;
+    TaskHandle_t _task;
+    esp_timer_handle_t _timer;
+    uint32_t _periodUs;
+    // Only the acquisition task changes it once begun; other tasks read
+    // the fields setInput() does not touch.
+    ScanList _scan;
+    // Per channel, the input asked for and its generation, (generation << 8)
+    // | mux, so a request is posted in one store.
+    std::atomic<uint16_t> _requests[SCAN_MAX_CHANNELS];
+    uint8_t _generations[SCAN_MAX_CHANNELS]; // Applied; acquisition task only
+    SampleBus<ACQ_BUS_SIZE> _bus;
+    volatile uint32_t _failedReads;
+};
+
+#endif // ACQUISITION_MANAGER_H
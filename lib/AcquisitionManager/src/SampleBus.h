@@ -0,0 +1,139 @@
+// File Path: /lib/AcquisitionManager/src/SampleBus.h
+// NEW FILE
+
+#ifndef SAMPLE_BUS_H
+#define SAMPLE_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * @struct SampleRecord
+ * @brief --- NEW: One ADC conversion as taken by the acquisition task. ---
+ */
+struct SampleRecord {
+    uint32_t timestampUs; // When the conversion was read, esp_timer time (wraps after 71 min)
+    uint8_t channel;      // Scan channel; a probe's is its ADC index
+    uint8_t generation;   // --- NEW: The channel's input switch it was taken after ---
+    int16_t rawCount;     // Signed ADS1118 result
+};
+
+/**
+ * @struct SampleCursor
+ * @brief --- NEW: One consumer's read position on a SampleBus. ---
+ * Owned by the consumer; the bus never sees it except when called with it.
+ */
+struct SampleCursor {
+    uint32_t position = 0; // Sequence number of the next record to read
+    uint32_t overruns = 0; // Records skipped because this consumer fell behind
+};
+
+/**
+ * @class SampleBus
+ * @brief --- NEW: A lock-free single-producer, multi-consumer ring. ---
+ *
+ * The producer publishes records and never waits: the ring has no notion of
+ * being full, and the oldest record is simply overwritten. Each consumer
+ * keeps its own SampleCursor, so any number of them (filters, graph,
+ * logger, analyser) see the same stream without extra ADC conversions.
+ *
+ * peek() hands out the records in place rather than copying them. A
+ * consumer that has fallen more than half the ring behind is moved up to
+ * the newest half and the records it missed are counted in its overruns,
+ * which leaves it half a ring of publishes to finish with what it peeked.
+ * consume() then checks that none of them was overwritten in the meantime.
+ *
+ * Sequence numbers run freely and are masked on use, so N must be a power
+ * of two.
+ */
+template <size_t N>
+class SampleBus {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SampleBus size must be a power of two");
+
+public:
+    SampleBus() : _head(0) {}
+
+    // --- Producer ---
+    void publish(const SampleRecord& record) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        _records[head & (N - 1)] = record;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    // --- Consumers ---
+
+    // Starts a cursor at the next record to be published.
+    void attach(SampleCursor& cursor) const {
+        cursor.position = _head.load(std::memory_order_acquire);
+    }
+
+    // Records published since the cursor, including any already overwritten.
+    size_t pending(const SampleCursor& cursor) const {
+        return _head.load(std::memory_order_acquire) - cursor.position;
+    }
+
+    /**
+     * @brief Points 'records' at the oldest unread records, in place.
+     * @return How many may be read there: up to the newest record or the
+     * end of the ring, whichever is first. Follow with consume().
+     */
+    size_t peek(SampleCursor& cursor, const SampleRecord*& records) {
+        uint32_t head = _head.load(std::memory_order_acquire);
+        uint32_t behind = head - cursor.position;
+        if (behind > N / 2) {
+            cursor.overruns += behind - N / 2;
+            cursor.position = head - N / 2;
+            behind = N / 2;
+        }
+        size_t offset = cursor.position & (N - 1);
+        records = &_records[offset];
+        return (behind < N - offset) ? behind : N - offset;
+    }
+
+    /**
+     * @brief Moves the cursor past 'count' peeked records.
+     * @return False if the producer overwrote any of them while they were
+     * in use; they are counted as overruns.
+     */
+    bool consume(SampleCursor& cursor, size_t count) {
+        // The records were read before the head is checked again.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        // The record at 'head' may be being written, which clobbers the
+        // one N before it.
+        bool intact = head - cursor.position < N;
+        if (!intact) cursor.overruns += count;
+        cursor.position += count;
+        return intact;
+    }
+
+    /**
+     * @brief peek() and consume() into a buffer, for consumers that keep
+     * the records. Overwritten records are dropped.
+     * @return The number copied to 'out'.
+     */
+    size_t read(SampleCursor& cursor, SampleRecord* out, size_t max) {
+        size_t copied = 0;
+        while (copied < max) {
+            const SampleRecord* records;
+            size_t count = peek(cursor, records);
+            if (count == 0) break;
+            if (count > max - copied) count = max - copied;
+            for (size_t i = 0; i < count; ++i) out[copied + i] = records[i];
+            if (consume(cursor, count)) copied += count;
+        }
+        return copied;
+    }
+
+    // Skips everything published so far.
+    void skip(SampleCursor& cursor) const { attach(cursor); }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    SampleRecord _records[N];
+    std::atomic<uint32_t> _head;
+};
+
+#endif // SAMPLE_BUS_H
@@ -10,10 +10,13 @@ AdcManager::AdcManager() :
     _adc1(nullptr),
     _adc2(nullptr),
     _spiMutex(nullptr),
-    _sdCsPin(0)
+    _sdCsPin(0),
+    _scheduler(*this)
 {
     _probeState[0] = ProbeState::DORMANT;
     _probeState[1] = ProbeState::DORMANT;
+    _lastCounts[0] = 0;
+    _lastCounts[1] = 0;
 }
 
 bool AdcManager::begin(FaultHandler& faultHandler, SPIClass* spiBus, SemaphoreHandle_t spiMutex, uint8_t sdCsPin) {
@@ -60,45 +63,211 @@ double AdcManager::getVoltage(uint8_t adcIndex, uint8_t inputs) {
  * @brief --- NEW: Implementation of the non-locking getVoltage method. ---
  * This function contains the core ADC reading logic and is now called by both
  * the standard getVoltage and the GuidedTuningEngine.
+ * One single-shot conversion, started at once and DRDY-paced, instead of
+ * starting two and sleeping through them.
+ * @return NaN if the ADC did not deliver a conversion in time.
  */
 double AdcManager::getVoltage_noLock(uint8_t adcIndex, uint8_t inputs) {
     if (!_initialized || adcIndex > 1) return 0.0;
     if (_probeState[adcIndex] == ProbeState::DORMANT) return 0.0;
 
+    int16_t counts;
+    if (!readSingle_noLock(adcIndex, inputs, counts)) return NAN;
+    // The scale includes the voltage divider on the probe inputs.
+    return counts * getMilliVoltsPerCount(adcIndex, inputs);
+}
+
+/**
+ * @brief --- NEW: One DRDY-paced conversion. The caller holds the SPI mutex,
+ * which is only needed for the wait (at most one conversion time) and a
+ * single 32-bit transfer. ---
+ */
+bool AdcManager::readContinuous_noLock(uint8_t adcIndex, uint8_t inputs, int16_t& counts) {
     ADS1118* adc = (adcIndex == 0) ? _adc1 : _adc2;
     uint8_t currentCsPin = (adcIndex == 0) ? ADC1_CS_PIN : ADC2_CS_PIN;
-    
+
     deselectOtherSlaves(currentCsPin);
+    _vspi->beginTransaction(SPISettings(ADS1118::SCLK, MSBFIRST, SPI_MODE1));
+    bool ok = adc->getCountsContinuous(ADC_DRDY_PIN, inputs, counts);
+    _vspi->endTransaction();
+    return ok;
+}
 
+/**
+ * @brief --- NEW: Ends a run of readContinuous_noLock() with its last
+ * conversion, leaving the chip in single-shot mode. ---
+ */
+bool AdcManager::stopContinuous_noLock(uint8_t adcIndex, int16_t& counts) {
+    ADS1118* adc = (adcIndex == 0) ? _adc1 : _adc2;
+    uint8_t currentCsPin = (adcIndex == 0) ? ADC1_CS_PIN : ADC2_CS_PIN;
+
+    deselectOtherSlaves(currentCsPin);
     _vspi->beginTransaction(SPISettings(ADS1118::SCLK, MSBFIRST, SPI_MODE1));
-    
-    // The "Priming Read" is critical for stable readings.
-    adc->getMilliVolts(inputs); 
-    double voltage = adc->getMilliVolts(inputs);
+    bool ok = adc->stopContinuous(ADC_DRDY_PIN, counts);
+    _vspi->endTransaction();
+    return ok;
+}
 
+/**
+ * @brief --- NEW: One single-shot conversion, run by the ConversionScheduler
+ * as a set of one. The caller holds the SPI mutex. The chip is left in
+ * single-shot mode, so the next scheduled set need not drop a conversion. ---
+ */
+bool AdcManager::readSingle_noLock(uint8_t adcIndex, uint8_t inputs, int16_t& counts) {
+    ConversionSlot slot;
+    slot.chip = adcIndex;
+    slot.config = slotConfig(adcIndex, inputs);
+    bool ok = false;
+    _vspi->beginTransaction(SPISettings(ADS1118::SCLK, MSBFIRST, SPI_MODE1));
+    _scheduler.run(&slot, 1, &counts, &ok);
     _vspi->endTransaction();
+    return ok;
+}
+
+// A conversion's config word, from its ADC's current range and rate.
+uint16_t AdcManager::slotConfig(uint8_t adcIndex, uint8_t inputs) {
+    Config config = chip(adcIndex)->configRegister;
+    config.bits.sensorMode = ADS1118::ADC_MODE;
+    config.bits.mux = inputs;
+    return config.word;
+}
+
+int16_t AdcManager::getCounts(uint8_t adcIndex, uint8_t inputs) {
+    if (!isProbeActive(adcIndex)) return 0;
+    int16_t counts;
+    // On a timeout the last good reading stands in; counts have no NaN.
+    if (readCounts(adcIndex, inputs, counts)) _lastCounts[adcIndex] = counts;
+    return _lastCounts[adcIndex];
+}
+
+bool AdcManager::readCounts(uint8_t adcIndex, uint8_t inputs, int16_t& counts) {
+    if (!_initialized || _spiMutex == nullptr || adcIndex > 1) return false;
+    if (_probeState[adcIndex] == ProbeState::DORMANT) return false;
 
+    bool ok = false;
+    if (xSemaphoreTake(_spiMutex, portMAX_DELAY) == pdTRUE) {
+        ok = readSingle_noLock(adcIndex, inputs, counts);
+        xSemaphoreGive(_spiMutex);
+    }
+    return ok;
+}
+
+double AdcManager::getMilliVoltsPerCount(uint8_t adcIndex, uint8_t inputs) {
+    if (!_initialized || adcIndex > 1) return 0.0;
+    ADS1118* adc = (adcIndex == 0) ? _adc1 : _adc2;
     // Account for the voltage divider on the probe inputs.
-    if(inputs == ADS1118::DIFF_0_1) {
-        voltage *= 2.0;
+    return adc->getMilliVoltsPerCount() * getInputDivider(inputs);
+}
+
+double AdcManager::getInputDivider(uint8_t inputs) {
+    return (inputs == ADS1118::DIFF_0_1) ? 2.0 : 1.0;
+}
+
+size_t AdcManager::getVoltageBurst(uint8_t adcIndex, uint8_t inputs, double* voltages, size_t count, double* sampleRate) {
+    if (!_initialized || _spiMutex == nullptr || adcIndex > 1) return 0;
+    if (_probeState[adcIndex] == ProbeState::DORMANT) return 0;
+
+    int16_t counts[ADC_MAX_BURST_SAMPLES];
+    if (count > ADC_MAX_BURST_SAMPLES) count = ADC_MAX_BURST_SAMPLES;
+    if (count == 0) return 0;
+
+    // Every conversion in continuous mode, each one DRDY-paced, so the
+    // burst runs at the ADC's own 860 SPS. The last one puts the chip back
+    // in single-shot mode: continuous mode lasts only as long as the burst.
+    if (xSemaphoreTake(_spiMutex, portMAX_DELAY) != pdTRUE) return 0;
+    size_t taken = 0;
+    if (count == 1) {
+        taken = readSingle_noLock(adcIndex, inputs, counts[0]) ? 1 : 0;
+    } else if (readContinuous_noLock(adcIndex, inputs, counts[0])) {
+        uint32_t start = micros();
+        taken = 1;
+        while (taken + 1 < count && readContinuous_noLock(adcIndex, inputs, counts[taken])) taken++;
+        // After a timeout the chip is left converting; the scheduler
+        // switches it over at its next set.
+        if (taken + 1 == count && stopContinuous_noLock(adcIndex, counts[taken])) taken++;
+        uint32_t elapsed = micros() - start;
+        // The first conversion starts the clock: taken - 1 intervals.
+        if (sampleRate) *sampleRate = (elapsed > 0 && taken > 1) ? (taken - 1) * 1e6 / elapsed : 0.0;
     }
+    xSemaphoreGive(_spiMutex);
+    count = taken;
 
-    return voltage;
+    double scale = getMilliVoltsPerCount(adcIndex, inputs);
+    for (size_t i = 0; i < count; ++i) voltages[i] = counts[i] * scale;
+    return count;
 }
 
+size_t AdcManager::readInterleaved(const AdcRequest* requests, size_t count, int16_t* counts, bool* ok) {
+    if (count > SCHED_MAX_SLOTS) count = SCHED_MAX_SLOTS;
+    for (size_t i = 0; i < count; ++i) ok[i] = false;
+    if (!_initialized || _spiMutex == nullptr) return 0;
 
-void AdcManager::setProbeState(uint8_t adcIndex, ProbeState state) {
-    if (!_initialized || adcIndex > 1) return;
-    ADS1118* adc = (adcIndex == 0) ? _adc1 : _adc2;
-    _probeState[adcIndex] = state;
+    ConversionSlot slots[SCHED_MAX_SLOTS];
+    size_t slotOf[SCHED_MAX_SLOTS];
+    size_t slotCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!isProbeActive(requests[i].adcIndex)) continue;
+        slots[slotCount].chip = requests[i].adcIndex;
+        slots[slotCount].config = slotConfig(requests[i].adcIndex, requests[i].inputs);
+        slotOf[slotCount++] = i;
+    }
+    if (slotCount == 0) return 0;
+
+    int16_t slotCounts[SCHED_MAX_SLOTS];
+    bool slotOk[SCHED_MAX_SLOTS];
+    size_t good = convert(slots, slotCount, slotCounts, slotOk);
+    for (size_t s = 0; s < slotCount; ++s) {
+        counts[slotOf[s]] = slotCounts[s];
+        ok[slotOf[s]] = slotOk[s];
+    }
+    return good;
+}
+
+size_t AdcManager::convert(const ConversionSlot* slots, size_t count, int16_t* counts, bool* ok) {
+    if (count > SCHED_MAX_SLOTS) count = SCHED_MAX_SLOTS;
+    for (size_t i = 0; i < count; ++i) ok[i] = false;
+    if (!_initialized || _spiMutex == nullptr) return 0;
+
+    size_t good = 0;
     if (xSemaphoreTake(_spiMutex, portMAX_DELAY) == pdTRUE) {
-        if (state == ProbeState::ACTIVE) {
-            adc->setContinuousMode();
-        } else {
-            adc->setSingleShotMode();
-        }
+        _vspi->beginTransaction(SPISettings(ADS1118::SCLK, MSBFIRST, SPI_MODE1));
+        good = _scheduler.run(slots, count, counts, ok);
+        _vspi->endTransaction();
         xSemaphoreGive(_spiMutex);
     }
+    return good;
+}
+
+// --- ConversionBus: the scheduler's view of the two ADCs. The caller
+// holds the SPI mutex and transaction. ---
+
+void AdcManager::select(uint8_t adcIndex) {
+    deselectOtherSlaves((adcIndex == 0) ? ADC1_CS_PIN : ADC2_CS_PIN);
+    chip(adcIndex)->select();
+}
+
+void AdcManager::deselect(uint8_t adcIndex) {
+    chip(adcIndex)->deselect();
+}
+
+bool AdcManager::waitReady(uint8_t adcIndex) {
+    return chip(adcIndex)->waitConversion(ADC_DRDY_PIN);
+}
+
+uint32_t AdcManager::exchange(uint8_t adcIndex, uint16_t config) {
+    return chip(adcIndex)->exchange(config);
+}
+
+uint16_t AdcManager::writtenConfig(uint8_t adcIndex) {
+    return chip(adcIndex)->getWrittenConfig();
+}
+
+// The chip's mode is left alone: it stays in single-shot mode, which the
+// ConversionScheduler and getVoltage() both use, and only a burst runs it
+// in continuous mode.
+void AdcManager::setProbeState(uint8_t adcIndex, ProbeState state) {
+    if (!_initialized || adcIndex > 1) return;
+    _probeState[adcIndex] = state;
 }
 
 bool AdcManager::isProbeActive(uint8_t adcIndex) {
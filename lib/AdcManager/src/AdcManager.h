@@ -8,15 +8,31 @@
 #include <ADS1118.h>
 #include "ProjectConfig.h"
 #include <FaultHandler.h>
+#include <ConversionScheduler.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 
+// Conversions taken in one burst when a probe is activated: about 37 ms
+// at 860 SPS, enough to fill the LF median window twice.
+#define ADC_BURST_SAMPLES 32
+// The longest burst getVoltageBurst() takes, as used for the mains hum test.
+#define ADC_MAX_BURST_SAMPLES 192
+
+/**
+ * @struct AdcRequest
+ * @brief --- NEW: One reading for AdcManager::readInterleaved(). ---
+ */
+struct AdcRequest {
+    uint8_t adcIndex;
+    uint8_t inputs;
+};
+
 enum class ProbeState {
     DORMANT,
     ACTIVE
 };
 
-class AdcManager {
+class AdcManager : private ConversionBus {
 public:
     AdcManager();
     bool begin(FaultHandler& faultHandler, SPIClass* spiBus, SemaphoreHandle_t spiMutex, uint8_t sdCsPin);
@@ -31,12 +47,79 @@ public:
      */
     double getVoltage_noLock(uint8_t adcIndex, uint8_t inputs);
 
+    /**
+     * @brief --- NEW: Reads the raw signed ADC counts for the fixed-point pipeline. ---
+     * Same locking and single-shot read as getVoltage, but without any conversion.
+     */
+    int16_t getCounts(uint8_t adcIndex, uint8_t inputs);
+
+    /**
+     * @brief --- NEW: getCounts() that reports a failed read instead of
+     * repeating the last one. ---
+     * @return False if the probe is dormant or the ADC timed out.
+     */
+    bool readCounts(uint8_t adcIndex, uint8_t inputs, int16_t& counts);
+
+    /**
+     * @brief --- NEW: Millivolts represented by one count of getCounts(). ---
+     * Derived from the ADC's active PGA range and includes the probe input
+     * divider, so counts * scale equals what getVoltage would return.
+     */
+    double getMilliVoltsPerCount(uint8_t adcIndex, uint8_t inputs);
+
+    // --- NEW: The probe input divider on an input: 2 on DIFF_0_1, else 1. ---
+    static double getInputDivider(uint8_t inputs);
+
+    /**
+     * @brief --- NEW: Takes 'count' back-to-back conversions at the ADC's
+     * full 860 SPS, holding the SPI bus for the whole burst. ---
+     * Used to pre-fill the filters when a probe is activated. The ADC runs
+     * in continuous mode for the burst only and is left in single-shot mode.
+     * @param voltages Receives the readings in millivolts, as getVoltage.
+     * @param sampleRate --- NEW: If given, receives the rate the burst was
+     * actually taken at, in Hz. ---
+     * @return The number of readings taken; 0 if the probe is dormant.
+     */
+    size_t getVoltageBurst(uint8_t adcIndex, uint8_t inputs, double* voltages, size_t count, double* sampleRate = nullptr);
+
+    /**
+     * @brief --- NEW: Takes several readings in one go, the two ADCs'
+     * conversions overlapped (see ConversionScheduler). ---
+     * Both probes and both rails cost about two conversion times instead of
+     * four, and no conversion is dropped for a change of input. Holds the
+     * SPI bus for the whole set. Requests for a dormant probe fail.
+     * @param ok Receives whether each reading is good.
+     * @return The number of good readings.
+     */
+    size_t readInterleaved(const AdcRequest* requests, size_t count, int16_t* counts, bool* ok);
+
+    /**
+     * @brief --- NEW: Runs conversions whose config words are already built
+     * (see ScanList), interleaved as readInterleaved(). ---
+     * A dormant probe's ADC is converted too: the scheduler only uses
+     * single-shot mode, in which the chip powers down between conversions.
+     * @return The number of good readings.
+     */
+    size_t convert(const ConversionSlot* slots, size_t count, int16_t* counts, bool* ok);
+
     void setProbeState(uint8_t adcIndex, ProbeState state);
     bool isProbeActive(uint8_t adcIndex);
 
 
 private:
     void deselectOtherSlaves(uint8_t activeAdcCsPin);
+    bool readContinuous_noLock(uint8_t adcIndex, uint8_t inputs, int16_t& counts);
+    bool stopContinuous_noLock(uint8_t adcIndex, int16_t& counts);
+    bool readSingle_noLock(uint8_t adcIndex, uint8_t inputs, int16_t& counts);
+    uint16_t slotConfig(uint8_t adcIndex, uint8_t inputs);
+    ADS1118* chip(uint8_t adcIndex) { return (adcIndex == 0) ? _adc1 : _adc2; }
+
+    // --- ConversionBus, for the scheduler ---
+    void select(uint8_t chip) override;
+    void deselect(uint8_t chip) override;
+    bool waitReady(uint8_t chip) override;
+    uint32_t exchange(uint8_t chip, uint16_t config) override;
+    uint16_t writtenConfig(uint8_t chip) override;
 
     FaultHandler* _faultHandler;
     bool _initialized;
@@ -46,6 +129,8 @@ private:
     SemaphoreHandle_t _spiMutex;
     uint8_t _sdCsPin;
     ProbeState _probeState[2];
+    int16_t _lastCounts[2];
+    ConversionScheduler _scheduler;
 };
 
 #endif // ADC_MANAGER_H
\ No newline at end of file
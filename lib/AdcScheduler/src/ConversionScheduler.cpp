@@ -0,0 +1,91 @@
+// File Path: /lib/AdcScheduler/src/ConversionScheduler.cpp
+// NEW FILE
+
+#include "ConversionScheduler.h"
+
+// Sentinel for "no conversion in flight".
+static const int NONE = -1;
+
+uint32_t ConversionScheduler::frame(uint8_t chip, uint16_t config) {
+    _bus.select(chip);
+    uint32_t result = _bus.exchange(chip, config);
+    _bus.deselect(chip);
+    return result;
+}
+
+size_t ConversionScheduler::run(const ConversionSlot* slots, size_t count, int16_t* counts, bool* ok) {
+    if (count > SCHED_MAX_SLOTS) count = SCHED_MAX_SLOTS;
+
+    // Each chip's slots, in order.
+    int queue[SCHED_MAX_CHIPS][SCHED_MAX_SLOTS];
+    size_t queued[SCHED_MAX_CHIPS] = {0};
+    size_t next[SCHED_MAX_CHIPS] = {0};
+    int inFlight[SCHED_MAX_CHIPS];
+    bool inFlightValid[SCHED_MAX_CHIPS];
+    for (size_t i = 0; i < count; ++i) {
+        ok[i] = false;
+        counts[i] = 0;
+        if (slots[i].chip < SCHED_MAX_CHIPS) {
+            queue[slots[i].chip][queued[slots[i].chip]++] = (int)i;
+        }
+    }
+
+    // Start every chip on its first slot.
+    for (uint8_t c = 0; c < SCHED_MAX_CHIPS; ++c) {
+        inFlight[c] = NONE;
+        if (queued[c] == 0) continue;
+        uint16_t config = slots[queue[c][0]].config | SCHED_CFG_START | SCHED_CFG_SINGLE_SHOT | SCHED_CFG_VALID;
+        if (!(_bus.writtenConfig(c) & SCHED_CFG_SINGLE_SHOT)) {
+            // Out of continuous mode: the conversion under way still has
+            // the old settings, so it is waited out and dropped.
+            frame(c, config);
+            _bus.select(c);
+            bool ready = _bus.waitReady(c);
+            _bus.deselect(c);
+            if (!ready) continue;
+        }
+        uint32_t readback = frame(c, config);
+        inFlight[c] = queue[c][0];
+        inFlightValid[c] = ((uint16_t)readback & SCHED_CFG_SETTINGS) == (config & SCHED_CFG_SETTINGS);
+        next[c] = 1;
+    }
+
+    // Take turns: read each chip's finished conversion and start its next.
+    size_t good = 0;
+    bool busy = true;
+    while (busy) {
+        busy = false;
+        for (uint8_t c = 0; c < SCHED_MAX_CHIPS; ++c) {
+            if (inFlight[c] == NONE) continue;
+            _bus.select(c);
+            if (!_bus.waitReady(c)) {
+                // The chip stopped answering; its remaining slots fail.
+                _bus.deselect(c);
+                inFlight[c] = NONE;
+                continue;
+            }
+            int done = inFlight[c];
+            // The next slot's config, or the same settings with NOP = 00,
+            // which reads without starting anything.
+            uint16_t config;
+            if (next[c] < queued[c]) {
+                inFlight[c] = queue[c][next[c]++];
+                config = slots[inFlight[c]].config | SCHED_CFG_START | SCHED_CFG_SINGLE_SHOT | SCHED_CFG_VALID;
+            } else {
+                inFlight[c] = NONE;
+                config = (slots[done].config | SCHED_CFG_SINGLE_SHOT) & ~SCHED_CFG_VALID;
+            }
+            uint32_t result = _bus.exchange(c, config);
+            _bus.deselect(c);
+
+            counts[done] = (int16_t)(result >> 16);
+            ok[done] = inFlightValid[c];
+            good += ok[done] ? 1 : 0;
+            if (inFlight[c] != NONE) {
+                inFlightValid[c] = ((uint16_t)result & SCHED_CFG_SETTINGS) == (config & SCHED_CFG_SETTINGS);
+                busy = true;
+            }
+        }
+    }
+    return good;
+}
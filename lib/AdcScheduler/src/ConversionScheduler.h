@@ -0,0 +1,104 @@
+// File Path: /lib/AdcScheduler/src/ConversionScheduler.h
+// NEW FILE
+
+#ifndef CONVERSION_SCHEDULER_H
+#define CONVERSION_SCHEDULER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ADS1118 chips on the bus, and conversions one run() may take.
+#define SCHED_MAX_CHIPS 2
+#define SCHED_MAX_SLOTS 8
+
+// The ADS1118 config register bits the scheduler drives itself.
+#define SCHED_CFG_START       0x8000 // SS: start a single-shot conversion
+#define SCHED_CFG_SINGLE_SHOT 0x0100 // MODE: power down after each conversion
+#define SCHED_CFG_VALID       0x0002 // NOP = 01: the word is written
+// Settings that must read back as written; the NOP, reserved and start
+// bits do not.
+#define SCHED_CFG_SETTINGS    0x7FF8
+
+/**
+ * @class ConversionBus
+ * @brief --- NEW: What the ConversionScheduler needs from the SPI bus. ---
+ *
+ * AdcManager implements it over the VSPI bus and the ADS1118 drivers; the
+ * host tests implement it with a simulated pair of chips. Chips are
+ * numbered from 0, as the AdcManager's ADC index.
+ */
+class ConversionBus {
+public:
+    virtual ~ConversionBus() {}
+
+    // Chip select low / high.
+    virtual void select(uint8_t chip) = 0;
+    virtual void deselect(uint8_t chip) = 0;
+
+    /**
+     * @brief With the chip selected, waits for DOUT/DRDY to show a finished
+     * conversion.
+     * @return False on a timeout.
+     */
+    virtual bool waitReady(uint8_t chip) = 0;
+
+    /**
+     * @brief One 32-bit frame with the chip selected: 'config' goes out
+     * twice, and the last result and the config readback come back.
+     * @return The result in the top 16 bits, the readback in the bottom.
+     */
+    virtual uint32_t exchange(uint8_t chip, uint16_t config) = 0;
+
+    // The config word last written to the chip, 0 if unknown.
+    virtual uint16_t writtenConfig(uint8_t chip) = 0;
+};
+
+/**
+ * @struct ConversionSlot
+ * @brief --- NEW: One conversion for the scheduler: which chip, and the
+ * config word to take it with (mux, PGA, rate, sensor mode). The start,
+ * mode and NOP bits are the scheduler's own. ---
+ */
+struct ConversionSlot {
+    uint8_t chip;
+    uint16_t config;
+};
+
+/**
+ * @class ConversionScheduler
+ * @brief --- NEW: Takes a set of ADS1118 conversions with the chips'
+ * conversion times overlapped. ---
+ *
+ * Each chip is run in single-shot mode. The frame that reads a chip's
+ * finished conversion also writes the config of its next one, which
+ * starts at once, so no conversion is thrown away for a change of input.
+ * While one chip converts, the scheduler waits on and reads the other:
+ * the chips take turns on the bus, and a run costs about as many
+ * conversion times as the busiest chip has slots, rather than the sum.
+ *
+ * Only one chip is ever selected, and every wait and frame happens
+ * between its select() and deselect(). A chip that was left in continuous
+ * mode (an AdcManager burst cut short by a timeout) is switched over first,
+ * which costs it one conversion.
+ */
+class ConversionScheduler {
+public:
+    explicit ConversionScheduler(ConversionBus& bus) : _bus(bus) {}
+
+    /**
+     * @brief Converts every slot once. Slots on the same chip are taken in
+     * the order given.
+     * @param counts Receives each slot's signed result.
+     * @param ok Receives whether each slot's result is good: false if its
+     * chip timed out or its config did not read back.
+     * @return The number of good results.
+     */
+    size_t run(const ConversionSlot* slots, size_t count, int16_t* counts, bool* ok);
+
+private:
+    uint32_t frame(uint8_t chip, uint16_t config);
+
+    ConversionBus& _bus;
+};
+
+#endif // CONVERSION_SCHEDULER_H
@@ -0,0 +1,44 @@
+// File Path: /lib/AdcScheduler/src/ScanList.cpp
+// NEW FILE
+
+#include "ScanList.h"
+
+// The ADS1118 config fields a scan channel does not choose.
+static const uint16_t CFG_TEMP_MODE = 0x0010; // TS_MODE: the on-chip sensor
+static const uint16_t CFG_PULL_UP   = 0x0008; // DOUT pull-up, as ADS1118::begin()
+static const uint16_t CFG_RESERVED  = 0x0001;
+
+// Full-scale range of each PGA setting, in millivolts.
+static const double PGA_FSR_MV[8] = {6144, 4096, 2048, 1024, 512, 256, 256, 256};
+// The temperature result is 14 bits, left-justified: 0.03125 °C per LSB.
+static const double TEMP_C_PER_COUNT = 0.03125 / 4;
+
+uint16_t ScanList::configWord(const ScanChannel& channel) {
+    uint16_t word = (uint16_t)((channel.mux & 0x7) << 12)
+                  | (uint16_t)((channel.pga & 0x7) << 9)
+                  | (uint16_t)((channel.rate & 0x7) << 5)
+                  | SCHED_CFG_SINGLE_SHOT | CFG_PULL_UP | SCHED_CFG_VALID | CFG_RESERVED;
+    if (channel.temperature) word |= CFG_TEMP_MODE;
+    return word;
+}
+
+int ScanList::add(const ScanChannel& channel) {
+    if (_count >= SCAN_MAX_CHANNELS || channel.chip >= SCHED_MAX_CHIPS) return -1;
+    _channels[_count] = channel;
+    _slots[_count].chip = channel.chip;
+    _slots[_count].config = configWord(channel);
+    return (int)_count++;
+}
+
+bool ScanList::setMux(size_t index, uint8_t mux) {
+    if (index >= _count) return false;
+    _channels[index].mux = mux;
+    _slots[index].config = configWord(_channels[index]);
+    return true;
+}
+
+double ScanList::unitsPerCount(size_t index) const {
+    if (index >= _count) return 0.0;
+    if (_channels[index].temperature) return TEMP_C_PER_COUNT;
+    return PGA_FSR_MV[_channels[index].pga & 0x7] / 32768;
+}
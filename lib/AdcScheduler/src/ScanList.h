@@ -0,0 +1,70 @@
+// File Path: /lib/AdcScheduler/src/ScanList.h
+// NEW FILE
+
+#ifndef SCAN_LIST_H
+#define SCAN_LIST_H
+
+#include "ConversionScheduler.h"
+
+// Channels in one scan, at most: one run() of the scheduler.
+#define SCAN_MAX_CHANNELS SCHED_MAX_SLOTS
+
+/**
+ * @struct ScanChannel
+ * @brief --- NEW: One input in a scan: which chip, and the ADS1118 field
+ * values to convert it with (MUX, PGA, DR). A temperature channel reads
+ * the chip's own sensor, and its mux is ignored. ---
+ */
+struct ScanChannel {
+    uint8_t chip;
+    uint8_t mux;
+    uint8_t pga;
+    uint8_t rate;
+    bool temperature;
+};
+
+/**
+ * @class ScanList
+ * @brief --- NEW: A fixed list of ADC channels, converted round-robin. ---
+ *
+ * Each channel's 16-bit config word is built once, when it is added or its
+ * mux changes, so a scan hands the words straight to the
+ * ConversionScheduler instead of rebuilding a config for every conversion.
+ * The index a channel was added at is its channel number.
+ */
+class ScanList {
+public:
+    ScanList() : _count(0) {}
+
+    /**
+     * @brief Appends a channel.
+     * @return Its index, or -1 if the list is full or the chip does not exist.
+     */
+    int add(const ScanChannel& channel);
+
+    // Switches a channel to another input; its word is rebuilt.
+    bool setMux(size_t index, uint8_t mux);
+
+    void clear() { _count = 0; }
+    size_t size() const { return _count; }
+    const ScanChannel& channel(size_t index) const { return _channels[index]; }
+
+    // The precomputed conversions, one per channel, in channel order.
+    const ConversionSlot* slots() const { return _slots; }
+
+    /**
+     * @brief What one count of a channel's result is worth at the ADC pins:
+     * millivolts, or degrees Celsius for a temperature channel.
+     */
+    double unitsPerCount(size_t index) const;
+
+    // The single-shot config word for a channel, without the start bit.
+    static uint16_t configWord(const ScanChannel& channel);
+
+private:
+    ScanChannel _channels[SCAN_MAX_CHANNELS];
+    ConversionSlot _slots[SCAN_MAX_CHANNELS];
+    size_t _count;
+};
+
+#endif // SCAN_LIST_H
@@ -9,17 +9,23 @@ double getTemperatureCorrectedBufferValue(double nominalValue, double temperatur
 
 CalibrationManager::CalibrationManager() : _faultHandler(nullptr), _initialized(false), _newPointsCount(0) {}
 bool CalibrationManager::begin(FaultHandler& faultHandler) { _faultHandler = &faultHandler; _initialized = true; return true; }
-double CalibrationManager::getCalibratedValue(double filteredVoltage) {
-    if (!_currentModel.isCalibrated) return 0.0;
-    return (_currentModel.coeff_a * std::pow(filteredVoltage, 2)) + (_currentModel.coeff_b * filteredVoltage) + _currentModel.coeff_c;
+// Evaluated in Horner form (a*v + b)*v + c: two multiply-adds in the
+// pipeline's sample_t instead of a libm pow() call per sample.
+sample_t CalibrationManager::getCalibratedValue(sample_t filteredVoltage) {
+    if (!_currentModel.isCalibrated) return 0.0f;
+    const sample_t a = (sample_t)_currentModel.coeff_a;
+    const sample_t b = (sample_t)_currentModel.coeff_b;
+    const sample_t c = (sample_t)_currentModel.coeff_c;
+    return (a * filteredVoltage + b) * filteredVoltage + c;
 }
-double CalibrationManager::getCompensatedValue(double rawValue, double measuredTemperature, bool isEC) {
+sample_t CalibrationManager::getCompensatedValue(sample_t rawValue, sample_t measuredTemperature, bool isEC) {
     if (isEC) {
-        const double ecAlpha = 0.0191; const double refTemp = 25.0;
-        return rawValue / (1.0 + ecAlpha * (measuredTemperature - refTemp));
+        const sample_t ecAlpha = (sample_t)0.0191; const sample_t refTemp = 25.0f;
+        return rawValue / (1.0f + ecAlpha * (measuredTemperature - refTemp));
     } else {
-        const double phAlpha = 0.003; const double neutralPh = 7.0;
-        return rawValue + ((rawValue - neutralPh) * (measuredTemperature - _currentModel.calibrationTemperature) * phAlpha);
+        const sample_t phAlpha = (sample_t)0.003; const sample_t neutralPh = 7.0f;
+        const sample_t calTemp = (sample_t)_currentModel.calibrationTemperature;
+        return rawValue + ((rawValue - neutralPh) * (measuredTemperature - calTemp) * phAlpha);
     }
 }
 void CalibrationManager::startNewCalibration() { _newPointsCount = 0; _newModel = CalibrationModel(); }
@@ -7,6 +7,7 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 #include <FaultHandler.h>
+#include "SampleType.h"
 
 #define CALIBRATION_POINT_COUNT 3
 
@@ -37,8 +38,8 @@ class CalibrationManager {
 public:
     CalibrationManager();
     bool begin(FaultHandler& faultHandler);
-    double getCalibratedValue(double filteredVoltage);
-    double getCompensatedValue(double rawValue, double measuredTemperature, bool isEC = false);
+    sample_t getCalibratedValue(sample_t filteredVoltage);
+    sample_t getCompensatedValue(sample_t rawValue, sample_t measuredTemperature, bool isEC = false);
     void startNewCalibration();
     bool addCalibrationPoint(double voltage, double knownValue, double temperature);
     double calculateNewModel(const CalibrationModel& previousModel);
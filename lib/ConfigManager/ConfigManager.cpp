@@ -30,25 +30,27 @@ bool ConfigManager::begin(FaultHandler& faultHandler, SdManager& sdManager) {
 bool ConfigManager::saveFilterSettings(FilterManager& filter, const char* filterName, const char* sessionTimestamp, bool is_saved_state) {
     if (!_initialized || !_sdManager) return false;
 
-    StaticJsonDocument<512> doc;
-    PI_Filter* hfFilter = filter.getFilter(0);
-    if (hfFilter) {
-        JsonObject hf = doc.createNestedObject("hf_filter");
-        hf["settleThreshold"] = hfFilter->settleThreshold;
-        hf["lockSmoothing"] = hfFilter->lockSmoothing;
-        hf["trackResponse"] = hfFilter->trackResponse;
-        hf["trackAssist"] = hfFilter->trackAssist;
-        hf["medianWindowSize"] = hfFilter->medianWindowSize;
+    StaticJsonDocument<1024> doc;
+    FilterPipelineConfig config = filter.getConfig();
+    JsonArray pipeline = doc.createNestedArray("pipeline");
+    for (size_t i = 0; i < config.stageCount; ++i) {
+        JsonObject stage = pipeline.createNestedObject();
+        writeStageConfig(stage, config.stages[i]);
     }
-    PI_Filter* lfFilter = filter.getFilter(1);
-    if (lfFilter) {
-        JsonObject lf = doc.createNestedObject("lf_filter");
-        lf["settleThreshold"] = lfFilter->settleThreshold;
-        lf["lockSmoothing"] = lfFilter->lockSmoothing;
-        lf["trackResponse"] = lfFilter->trackResponse;
-        lf["trackAssist"] = lfFilter->trackAssist;
-        lf["medianWindowSize"] = lfFilter->medianWindowSize;
+    // The HF and LF PI stages are also written under the original keys, so
+    // files stay readable by firmware that predates configurable pipelines.
+    // --- NEW: By role: behind a Hampel stage there is no HF key. ---
+    const char* legacyKeys[] = { "hf_filter", "lf_filter" };
+    for (int role = 0; role < 2; ++role) {
+        const FilterStageConfig* stage = config.piStage(role);
+        if (!stage) continue;
+        JsonObject legacy = doc.createNestedObject(legacyKeys[role]);
+        writeFilterParams(legacy, stage->params);
     }
+    StabilityCriteria criteria = filter.getStabilityCriteria();
+    JsonObject stability = doc.createNestedObject("stability");
+    stability["maxSlope"] = criteria.maxSlope;
+    stability["maxNoise"] = criteria.maxNoise;
 
     char filepath[128];
     if (strcmp(sessionTimestamp, "default") == 0) {
@@ -81,7 +83,7 @@ bool ConfigManager::loadFilterSettings(FilterManager& filter, const char* filter
         snprintf(filepath, sizeof(filepath), "/config/%s.json", filterName);
     }
 
-    StaticJsonDocument<512> doc;
+    StaticJsonDocument<1536> doc;
     LOG_STORAGE("Loading filter settings from %s", filepath);
     if (!_sdManager->loadJson(filepath, doc)) {
         LOG_STORAGE("File not found: %s", filepath);
@@ -89,26 +91,159 @@ bool ConfigManager::loadFilterSettings(FilterManager& filter, const char* filter
         return false;
     }
 
-    PI_Filter* hfFilter = filter.getFilter(0);
-    JsonObject hf = doc["hf_filter"];
-    if (hfFilter && !hf.isNull()) {
-        hfFilter->settleThreshold = hf["settleThreshold"];
-        hfFilter->lockSmoothing = hf["lockSmoothing"];
-        hfFilter->trackResponse = hf["trackResponse"];
-        hfFilter->trackAssist = hf["trackAssist"];
-        hfFilter->medianWindowSize = hf["medianWindowSize"];
+    // Published as one set, so a restore while the data task is running
+    // takes effect atomically at its next sample.
+    FilterPipelineConfig config;
+    JsonArray pipeline = doc["pipeline"];
+    if (!pipeline.isNull()) {
+        FilterPipelineConfig loaded;
+        for (JsonObject stage : pipeline) {
+            FilterStageConfig stageConfig;
+            if (!readStageConfig(stage, stageConfig) || !loaded.add(stageConfig)) {
+                LOG_STORAGE("Invalid pipeline in %s, keeping the current one", filepath);
+                return false;
+            }
+        }
+        config = loaded;
+    } else {
+        // Files without a pipeline only carry the HF/LF setpoints; they are
+        // applied to the current pipeline's PI stages in those roles.
+        config = filter.getConfig();
+        const char* legacyKeys[] = { "hf_filter", "lf_filter" };
+        for (int i = 0; i < 2; ++i) {
+            FilterStageConfig* stage = config.piStage(i);
+            JsonObject obj = doc[legacyKeys[i]];
+            if (stage && !obj.isNull()) {
+                readFilterParams(obj, stage->params);
+            }
+        }
     }
-
-    PI_Filter* lfFilter = filter.getFilter(1);
-    JsonObject lf = doc["lf_filter"];
-    if (lfFilter && !lf.isNull()) {
-        lfFilter->settleThreshold = lf["settleThreshold"];
-        lfFilter->lockSmoothing = lf["lockSmoothing"];
-        lfFilter->trackResponse = lf["trackResponse"];
-        lfFilter->trackAssist = lfFilter->trackAssist;
-        lfFilter->medianWindowSize = lf["medianWindowSize"];
+    if (!filter.configure(config)) {
+        LOG_STORAGE("Invalid pipeline in %s, keeping the current one", filepath);
+        return false;
+    }
+    JsonObject stability = doc["stability"];
+    if (!stability.isNull()) {
+        StabilityCriteria criteria = filter.getStabilityCriteria();
+        criteria.maxSlope = stability["maxSlope"] | criteria.maxSlope;
+        criteria.maxNoise = stability["maxNoise"] | criteria.maxNoise;
+        filter.setStabilityCriteria(criteria);
     }
 
     LOG_STORAGE("Successfully loaded settings from %s", filepath);
     return true;
-}
\ No newline at end of file
+}
+
+void ConfigManager::writeFilterParams(JsonObject& obj, const FilterParams& params) {
+    obj["settleThreshold"] = params.settleThreshold;
+    obj["lockSmoothing"] = params.lockSmoothing;
+    obj["trackResponse"] = params.trackResponse;
+    obj["trackAssist"] = params.trackAssist;
+    obj["medianWindowSize"] = params.medianWindowSize;
+}
+
+/**
+ * @brief Reads one stage's setpoints, keeping the current value for any key
+ * that is missing from the file.
+ */
+void ConfigManager::readFilterParams(const JsonObject& obj, FilterParams& params) {
+    FilterParams loaded = params;
+    loaded.settleThreshold = obj["settleThreshold"] | params.settleThreshold;
+    loaded.lockSmoothing = obj["lockSmoothing"] | params.lockSmoothing;
+    loaded.trackResponse = obj["trackResponse"] | params.trackResponse;
+    loaded.trackAssist = obj["trackAssist"] | params.trackAssist;
+    loaded.medianWindowSize = obj["medianWindowSize"] | params.medianWindowSize;
+    params = loaded;
+}
+
+/**
+ * @brief Writes one pipeline stage. PI stages carry their setpoints inline;
+ * the other types carry their window or decimation factor.
+ */
+void ConfigManager::writeStageConfig(JsonObject& obj, const FilterStageConfig& stage) {
+    obj["type"] = filterStageTypeName(stage.type);
+    switch (stage.type) {
+        case FilterStageType::PI:
+            writeFilterParams(obj, stage.params);
+            break;
+        case FilterStageType::DECIMATOR:
+            obj["factor"] = stage.size;
+            break;
+        case FilterStageType::HAMPEL:
+            obj["window"] = stage.size;
+            obj["threshold"] = stage.threshold;
+            break;
+        case FilterStageType::KALMAN:
+            obj["measurementNoise"] = stage.kalman.measurementNoise;
+            obj["processNoise"] = stage.kalman.processNoise;
+            obj["adaptRate"] = stage.kalman.adaptRate;
+            break;
+        case FilterStageType::NOTCH:
+            obj["frequency"] = stage.notch.frequency;
+            obj["sampleRate"] = stage.notch.sampleRate;
+            obj["quality"] = stage.notch.quality;
+            break;
+        default:
+            obj["window"] = stage.size;
+            break;
+    }
+}
+
+bool ConfigManager::readStageConfig(const JsonObject& obj, FilterStageConfig& stage) {
+    if (!filterStageTypeFromName(obj["type"].as<const char*>(), stage.type)) return false;
+    switch (stage.type) {
+        case FilterStageType::PI:
+            readFilterParams(obj, stage.params);
+            break;
+        case FilterStageType::DECIMATOR:
+            stage.size = obj["factor"] | 1;
+            break;
+        case FilterStageType::HAMPEL:
+            stage.size = obj["window"] | 1;
+            stage.threshold = obj["threshold"] | HAMPEL_DEFAULT_THRESHOLD;
+            break;
+        case FilterStageType::KALMAN:
+            stage.kalman.measurementNoise = obj["measurementNoise"] | stage.kalman.measurementNoise;
+            stage.kalman.processNoise = obj["processNoise"] | stage.kalman.processNoise;
+            stage.kalman.adaptRate = obj["adaptRate"] | stage.kalman.adaptRate;
+            break;
+        case FilterStageType::NOTCH:
+            stage.notch.frequency = obj["frequency"] | stage.notch.frequency;
+            stage.notch.sampleRate = obj["sampleRate"] | stage.notch.sampleRate;
+            stage.notch.quality = obj["quality"] | stage.notch.quality;
+            break;
+        default:
+            stage.size = obj["window"] | 1;
+            break;
+    }
+    return stage.isValid();
+}
+
+bool ConfigManager::saveFilterState(FilterManager& filter, const char* filterName, uint32_t now) {
+    if (!_initialized || !_sdManager) return false;
+
+    FilterStateBlob blob;
+    filter.saveState(blob, now);
+    if (blob.piCount == 0) return false;
+
+    char filepath[128];
+    snprintf(filepath, sizeof(filepath), "/config/%s_state.bin", filterName);
+    LOG_STORAGE("Saving filter runtime state to %s", filepath);
+    return _sdManager->saveBinary(filepath, &blob, blob.size());
+}
+
+bool ConfigManager::loadFilterState(FilterManager& filter, const char* filterName, uint32_t now, sample_t currentValue) {
+    if (!_initialized || !_sdManager) return false;
+
+    char filepath[128];
+    snprintf(filepath, sizeof(filepath), "/config/%s_state.bin", filterName);
+    FilterStateBlob blob;
+    memset(&blob, 0, sizeof(blob));
+    size_t bytesRead = _sdManager->loadBinary(filepath, &blob, sizeof(blob));
+    // A short read means a torn or foreign file; size() is only trusted once
+    // piCount is known to be in range.
+    if (bytesRead < offsetof(FilterStateBlob, stages) || blob.piCount > FILTER_MAX_STAGES || bytesRead != blob.size()) {
+        return false;
+    }
+    return filter.restoreState(blob, now, currentValue);
+}
@@ -41,7 +41,27 @@ public:
      */
     bool loadFilterSettings(FilterManager& filter, const char* filterName, bool is_saved_state = false);
 
+    /**
+     * @brief --- NEW: Saves a filter's runtime state for a warm start. ---
+     * Written as a binary blob to /config/<filterName>_state.bin.
+     * @param now Unix time, or 0 if the clock is not running.
+     */
+    bool saveFilterState(FilterManager& filter, const char* filterName, uint32_t now);
+
+    /**
+     * @brief Restores a filter's runtime state if it is still fresh; see
+     * FilterManager::restoreState. Must be called from the data task.
+     * @param currentValue A live reading of the channel.
+     * @return True if the filter was warm-started.
+     */
+    bool loadFilterState(FilterManager& filter, const char* filterName, uint32_t now, sample_t currentValue);
+
 private:
+    static void writeFilterParams(JsonObject& obj, const FilterParams& params);
+    static void readFilterParams(const JsonObject& obj, FilterParams& params);
+    static void writeStageConfig(JsonObject& obj, const FilterStageConfig& stage);
+    static bool readStageConfig(const JsonObject& obj, FilterStageConfig& stage);
+
     FaultHandler* _faultHandler;
     SdManager* _sdManager;
     bool _initialized;
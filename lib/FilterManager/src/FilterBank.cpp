@@ -0,0 +1,629 @@
+// File Path: /lib/FilterManager/src/FilterBank.cpp
+// NEW FILE
+
+#include "FilterBank.h"
+#include "FilterStagePool.h"
+#include "DebugConfig.h"
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+FilterBank& FilterBank::instance() {
+    static FilterBank bank;
+    return bank;
+}
+
+FilterBank::FilterBank() : _attached(0) {
+    for (int c = 0; c < FILTER_BANK_CHANNELS; ++c) {
+        _names[c] = "";
+        _stageCount[c] = 0;
+        _piCount[c] = 0;
+        _firstPiRole[c] = 0;
+        _value[c] = 0.0f;
+        _lastOutput[c] = 0.0f;
+        _fixedPath[c] = false;
+        _fixedResync[c] = false;
+        _fixedFallbackLogged[c] = false;
+        _paramSeq[c].store(0, std::memory_order_relaxed);
+        _appliedParamSeq[c] = 0;
+        _snapshots[c].store(nullptr, std::memory_order_relaxed);
+        _snapshotSeq[c] = 0;
+    }
+}
+
+FilterBank::~FilterBank() {
+    for (int c = 0; c < FILTER_BANK_CHANNELS; ++c) {
+        delete _snapshots[c].load(std::memory_order_relaxed);
+    }
+}
+
+// --- Channels ---
+
+int FilterBank::attach(const char* name, const FilterPipelineConfig& config) {
+    for (int c = 0; c < FILTER_BANK_CHANNELS; ++c) {
+        if (_attached & (1u << c)) continue;
+        _names[c] = name;
+        _stageCount[c] = 0;
+        _piCount[c] = 0;
+        if (!acquireStages(c, config)) {
+            releaseStages(c);
+            LOG_FILTER("FilterBank: stage pool exhausted, '%s' not attached", name);
+            return -1;
+        }
+        LOG_FILTER("FilterManager '%s' built a %u-stage pipeline", name, (unsigned)_stageCount[c]);
+        _config[c] = config;
+        _lastOutput[c] = 0.0f;
+        _stability[c].reset();
+        resetFixedFilters(c);
+        _publishedConfig[c] = _config[c];
+        _appliedParamSeq[c] = _paramSeq[c].load(std::memory_order_relaxed);
+        _snapshotSeq[c] = 0;
+        _attached |= (1u << c);
+        return c;
+    }
+    LOG_FILTER("FilterBank: no free channel for '%s'", name);
+    return -1;
+}
+
+void FilterBank::detach(int channel) {
+    if (channel < 0 || !(_attached & (1u << channel))) return;
+    releaseStages(channel);
+    delete _snapshots[channel].exchange(nullptr, std::memory_order_acq_rel);
+    _attached &= ~(1u << channel);
+}
+
+// --- Data path ---
+
+/**
+ * @brief The bank pass: stage by stage, across every masked channel.
+ * Channels whose stage at this depth is a network-sized PI median are
+ * grouped by window and finished with selectMedians(); every other stage is
+ * stepped on its own. A stage that produces no output (a decimator between
+ * outputs) drops its channel from the rest of the pass, holding the
+ * previous output as in the single-channel path.
+ */
+void FilterBank::process(const sample_t* in, sample_t* out, uint32_t channelMask) {
+    uint32_t live = channelMask & _attached;
+    size_t depth = 0;
+    for (int c = 0; c < FILTER_BANK_CHANNELS; ++c) {
+        if (!(live & (1u << c))) continue;
+        applyPendingConfig(c);
+        _value[c] = in[c];
+        depth = std::max(depth, _stageCount[c]);
+    }
+
+    for (size_t s = 0; s < depth; ++s) {
+        uint32_t lanes3 = 0, lanes5 = 0, lanes7 = 0;
+        for (int c = 0; c < FILTER_BANK_CHANNELS; ++c) {
+            uint32_t bit = 1u << c;
+            if (!(live & bit) || s >= _stageCount[c]) continue;
+            FilterStage* stage = _stages[s][c];
+            PI_Filter* filter = stage->getPIFilter();
+            int window = filter ? filter->params.medianWindowSize : 0;
+            // The network needs a full window; a filter still filling its
+            // history takes the single-channel path for those first samples.
+            bool network = (window == 3 || window == 5 || window == 7) &&
+                           filter->historySize() + 1 >= (size_t)window;
+            if (!network) {
+                if (!stage->process(_value[c], _value[c])) live &= ~bit;
+            } else if (!filter->pushWindow(_value[c])) {
+                _value[c] = filter->getFilteredValue(); // NaN sample, skipped
+            } else if (window == 3) {
+                lanes3 |= bit;
+            } else if (window == 5) {
+                lanes5 |= bit;
+            } else {
+                lanes7 |= bit;
+            }
+        }
+        if (lanes3) selectMedians<3>(s, lanes3);
+        if (lanes5) selectMedians<5>(s, lanes5);
+        if (lanes7) selectMedians<7>(s, lanes7);
+    }
+
+    for (int c = 0; c < FILTER_BANK_CHANNELS; ++c) {
+        uint32_t bit = 1u << c;
+        if (!(channelMask & _attached & bit)) continue;
+        if (live & bit) _lastOutput[c] = _value[c];
+        out[c] = _lastOutput[c];
+        _stability[c].push(out[c]);
+    }
+}
+
+/**
+ * @brief Finishes one PI stage for a group of channels. Their newest N raw
+ * samples are laid out one lane per channel, and a single network pass
+ * selects every median at once. Unused lanes carry zeros and are ignored.
+ */
+template <int N>
+void FilterBank::selectMedians(size_t stage, uint32_t lanes) {
+    SortingNetwork::Lanes<sample_t, FILTER_BANK_CHANNELS> window[N];
+    for (int c = 0; c < FILTER_BANK_CHANNELS; ++c) {
+        PI_Filter* filter = (lanes & (1u << c)) ? _stages[stage][c]->getPIFilter() : nullptr;
+        for (int k = 0; k < N; ++k) window[k].v[c] = filter ? filter->recentRaw(k) : (sample_t)0;
+    }
+    SortingNetwork::Lanes<sample_t, FILTER_BANK_CHANNELS> median = SortingNetwork::Median<N>::select(window);
+    for (int c = 0; c < FILTER_BANK_CHANNELS; ++c) {
+        if (lanes & (1u << c)) _value[c] = _stages[stage][c]->getPIFilter()->finishWindow(median.v[c]);
+    }
+}
+
+sample_t FilterBank::process(int channel, sample_t rawVoltage) {
+    applyPendingConfig(channel);
+    LOG_FILTER_PIPELINE("FilterManager '%s' received raw value: %.4f", _names[channel], rawVoltage);
+    sample_t output = processSample(channel, rawVoltage);
+    _stability[channel].push(output);
+    return output;
+}
+
+/**
+ * @brief Runs one sample through every stage. If a stage produces no output
+ * (a decimator between outputs), the rest of the chain is skipped and the
+ * previous pipeline output is held.
+ */
+sample_t FilterBank::processSample(int channel, sample_t value) {
+    for (size_t i = 0; i < _stageCount[channel]; ++i) {
+        if (!_stages[i][channel]->process(value, value)) {
+            return _lastOutput[channel];
+        }
+        LOG_FILTER_PIPELINE(" > Stage %u (%s) output: %.4f", (unsigned)i, filterStageTypeName(_stages[i][channel]->getType()), value);
+    }
+    _lastOutput[channel] = value;
+    return value;
+}
+
+void FilterBank::process(int channel, const sample_t* in, sample_t* out, size_t count) {
+    applyPendingConfig(channel);
+    LOG_FILTER_PIPELINE("FilterManager '%s' processing a batch of %u samples", _names[channel], (unsigned)count);
+    // Only PI stages are guaranteed one output per input, which the
+    // block-by-block path relies on.
+    size_t stageCount = _stageCount[channel];
+    if (_piCount[channel] != stageCount) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = processSample(channel, in[i]);
+            _stability[channel].push(out[i]);
+        }
+        return;
+    }
+    sample_t block[FILTER_BATCH_BLOCK];
+    for (size_t start = 0; start < count; start += FILTER_BATCH_BLOCK) {
+        size_t blockSize = std::min((size_t)FILTER_BATCH_BLOCK, count - start);
+        const sample_t* src = in + start;
+        for (size_t i = 0; i < stageCount; ++i) {
+            sample_t* dst = (i + 1 == stageCount) ? out + start : block;
+            _stages[i][channel]->process(src, dst, blockSize);
+            src = dst;
+        }
+    }
+    if (count > 0) _lastOutput[channel] = out[count - 1];
+    for (size_t i = 0; i < count; ++i) _stability[channel].push(out[i]);
+}
+
+/**
+ * @brief The fixed-point data path. Only the plain [pi, pi] pipeline has an
+ * integer twin; any other shape (a Hampel, Kalman, notch or decimator stage,
+ * or a configured chain) is filtered in floating point, with one log line
+ * each time a channel falls back.
+ */
+sample_t FilterBank::processCounts(int channel, int16_t rawCounts, float mvPerCount) {
+    applyPendingConfig(channel);
+    if (_piCount[channel] != 2 || _stageCount[channel] != 2) {
+        if (!_fixedFallbackLogged[channel]) {
+            LOG_FILTER("FilterManager '%s': only [pi, pi] has a fixed-point path, filtering this %u-stage pipeline in floating point",
+                       _names[channel], (unsigned)_stageCount[channel]);
+            _fixedFallbackLogged[channel] = true;
+        }
+        _fixedPath[channel] = false;
+        return process(channel, rawCounts * mvPerCount);
+    }
+    PI_FilterFixed& hf = _hfFixedFilter[channel];
+    PI_FilterFixed& lf = _lfFixedFilter[channel];
+    // Setpoints are shared with the floating-point filters; configure() only
+    // does work when they or the ADC range have changed.
+    hf.configure(_piFilters[0][channel]->params, mvPerCount);
+    lf.configure(_piFilters[1][channel]->params, mvPerCount);
+    if (_fixedResync[channel]) {
+        // Take over a prime or warm start from the floating-point stages.
+        PI_FilterState state;
+        _piFilters[0][channel]->saveState(state);
+        hf.restoreState(state);
+        _piFilters[1][channel]->saveState(state);
+        lf.restoreState(state);
+        _fixedResync[channel] = false;
+    }
+    _fixedPath[channel] = true;
+
+    LOG_FILTER_PIPELINE("FilterManager '%s' received raw counts: %d", _names[channel], rawCounts);
+    int32_t lfFiltered = lf.process(hf.process(PI_FilterFixed::fromCounts(rawCounts)));
+    sample_t output = lf.toMilliVolts(lfFiltered);
+    LOG_FILTER_PIPELINE(" > Fixed-point LF output: %.4f", output);
+    _lastOutput[channel] = output;
+    _stability[channel].push(output);
+    // Only once a reader has asked for graphs (see getSnapshot()).
+    if (_snapshots[channel].load(std::memory_order_relaxed)) publishSnapshot(channel);
+    return output;
+}
+
+/**
+ * @brief Restarts every stage with the PI filters seeded at the median of
+ * the burst, then runs the burst through the pipeline. The median windows
+ * and KPI histories fill with real samples, and the LF stage starts at the
+ * signal level instead of climbing to it from zero.
+ */
+void FilterBank::prime(int channel, const sample_t* samples, size_t count) {
+    if (count > FILTER_PRIME_MAX_SAMPLES) count = FILTER_PRIME_MAX_SAMPLES;
+    sample_t sorted[FILTER_PRIME_MAX_SAMPLES];
+    size_t valid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!std::isnan(samples[i])) sorted[valid++] = samples[i];
+    }
+    if (valid == 0) return;
+    std::nth_element(sorted, sorted + valid / 2, sorted + valid);
+    sample_t level = sorted[valid / 2];
+
+    applyPendingConfig(channel);
+    for (size_t i = 0; i < _stageCount[channel]; ++i) {
+        FilterStage* stage = _stages[i][channel];
+        stage->reset();
+        PI_Filter* filter = stage->getPIFilter();
+        if (filter) filter->seed(level);
+        KalmanFilter* kalman = stage->getKalmanFilter();
+        if (kalman) kalman->seed(level);
+    }
+    _lastOutput[channel] = level;
+    for (size_t i = 0; i < count; ++i) processSample(channel, samples[i]);
+    _fixedResync[channel] = true;
+    // The burst is not at the sample rate, so it says nothing about the slope.
+    _stability[channel].reset();
+    LOG_FILTER("FilterManager '%s' primed at %.3f from %u samples", _names[channel], level, (unsigned)count);
+}
+
+FilterStage* FilterBank::getStage(int channel, size_t index) {
+    return (index < _stageCount[channel]) ? _stages[index][channel] : nullptr;
+}
+
+PI_Filter* FilterBank::getFilter(int channel, int role) const {
+    int index = role - _firstPiRole[channel];
+    if (index < 0 || (size_t)index >= _piCount[channel]) return nullptr;
+    return _piFilters[index][channel];
+}
+
+KalmanFilter* FilterBank::getKalmanFilter(int channel) const {
+    for (size_t i = 0; i < _stageCount[channel]; ++i) {
+        KalmanFilter* filter = _stages[i][channel]->getKalmanFilter();
+        if (filter) return filter;
+    }
+    return nullptr;
+}
+
+PI_FilterFixed* FilterBank::getFixedFilter(int channel, int index) {
+    if (index == 0) return &_hfFixedFilter[channel];
+    if (index == 1) return &_lfFixedFilter[channel];
+    return nullptr;
+}
+
+void FilterBank::resetFixedFilters(int channel) {
+    _hfFixedFilter[channel] = PI_FilterFixed();
+    _lfFixedFilter[channel] = PI_FilterFixed();
+    _fixedPath[channel] = false;
+    _fixedResync[channel] = false;
+    _fixedFallbackLogged[channel] = false;
+}
+
+// --- Pipeline construction (boot, or the data task at a sample boundary) ---
+
+bool FilterBank::acquireStages(int channel, const FilterPipelineConfig& config) {
+    FilterStagePool& pool = FilterStagePool::instance();
+    FilterPipelineConfig running = config.atStageRates();
+    _firstPiRole[channel] = config.firstPiRole();
+    for (size_t i = 0; i < running.stageCount; ++i) {
+        FilterStage* stage = pool.acquire(running.stages[i]);
+        if (!stage) return false;
+        _stages[_stageCount[channel]++][channel] = stage;
+        PI_Filter* filter = stage->getPIFilter();
+        if (filter) _piFilters[_piCount[channel]++][channel] = filter;
+    }
+    return true;
+}
+
+void FilterBank::releaseStages(int channel) {
+    FilterStagePool& pool = FilterStagePool::instance();
+    for (size_t i = 0; i < _stageCount[channel]; ++i) pool.release(_stages[i][channel]);
+    _stageCount[channel] = 0;
+    _piCount[channel] = 0;
+}
+
+/**
+ * @brief Swaps the running stages for a new set from the pool. The old stages
+ * are returned first, so rebuilding the same shape always succeeds; if the
+ * pool cannot supply the new shape, the previous pipeline is restored.
+ */
+bool FilterBank::rebuildPipeline(int channel, const FilterPipelineConfig& config) {
+    FilterPipelineConfig previous = _config[channel];
+    releaseStages(channel);
+    if (acquireStages(channel, config)) {
+        _config[channel] = config;
+        _lastOutput[channel] = 0.0f;
+        _stability[channel].reset();
+        resetFixedFilters(channel);
+        LOG_FILTER("FilterManager '%s' built a %u-stage pipeline", _names[channel], (unsigned)_stageCount[channel]);
+        return true;
+    }
+    releaseStages(channel);
+    acquireStages(channel, previous);
+    LOG_FILTER("FilterManager '%s': stage pool exhausted, keeping the previous pipeline", _names[channel]);
+    return false;
+}
+
+bool FilterBank::configure(int channel, const FilterPipelineConfig& config) {
+    if (!config.isValid()) return false;
+    uint32_t seq = beginPublish(channel);
+    _publishedConfig[channel] = config;
+    _paramSeq[channel].store(seq + 1, std::memory_order_release);
+    return true;
+}
+
+FilterPipelineConfig FilterBank::getConfig(int channel) const {
+    FilterPipelineConfig config;
+    uint32_t seq;
+    do {
+        seq = _paramSeq[channel].load(std::memory_order_acquire);
+        config = _publishedConfig[channel];
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((seq & 1u) || _paramSeq[channel].load(std::memory_order_relaxed) != seq);
+    return config;
+}
+
+/**
+ * @brief --- NEW: Lock-free setpoint hand-over from the UI to the data task. ---
+ * Publishers make the sequence counter odd, write the block, and make it even
+ * again. The counter is claimed with a compare-exchange, so a second publisher
+ * (e.g. the tuning engine) waits out a write of a few words rather than
+ * interleaving with it. The data task itself never waits.
+ */
+void FilterBank::publishParams(int channel, int role, const FilterParams& params) {
+    uint32_t seq = beginPublish(channel);
+    FilterStageConfig* stage = _publishedConfig[channel].piStage(role);
+    if (stage) stage->params = params;
+    _paramSeq[channel].store(seq + 1, std::memory_order_release);
+}
+
+void FilterBank::publishParams(int channel, const FilterParams& hfParams, const FilterParams& lfParams) {
+    uint32_t seq = beginPublish(channel);
+    FilterStageConfig* hf = _publishedConfig[channel].piStage(0);
+    FilterStageConfig* lf = _publishedConfig[channel].piStage(1);
+    if (hf) hf->params = hfParams;
+    if (lf) lf->params = lfParams;
+    _paramSeq[channel].store(seq + 1, std::memory_order_release);
+}
+
+// Claims the block for writing and returns the (now odd) sequence number.
+uint32_t FilterBank::beginPublish(int channel) {
+    std::atomic<uint32_t>& sequence = _paramSeq[channel];
+    uint32_t seq = sequence.load(std::memory_order_relaxed) & ~1u;
+    while (!sequence.compare_exchange_weak(seq, seq + 1, std::memory_order_relaxed)) {
+        seq &= ~1u;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    return seq + 1;
+}
+
+void FilterBank::publishKalmanParams(int channel, const KalmanParams& params) {
+    uint32_t seq = beginPublish(channel);
+    FilterStageConfig* stage = _publishedConfig[channel].kalmanStage();
+    if (stage) stage->kalman = params;
+    _paramSeq[channel].store(seq + 1, std::memory_order_release);
+}
+
+FilterParams FilterBank::getParams(int channel, int role) const {
+    FilterPipelineConfig config = getConfig(channel);
+    const FilterStageConfig* stage = config.piStage(role);
+    return stage ? stage->params : FilterParams();
+}
+
+/**
+ * @brief Called by the data task at each sample boundary. Costs one atomic
+ * load when nothing has been published.
+ */
+void FilterBank::applyPendingConfig(int channel) {
+    uint32_t seq = _paramSeq[channel].load(std::memory_order_acquire);
+    if (seq == _appliedParamSeq[channel] || (seq & 1u)) return;
+    FilterPipelineConfig config = _publishedConfig[channel];
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_paramSeq[channel].load(std::memory_order_relaxed) != seq) return; // Torn; retry next sample
+    _appliedParamSeq[channel] = seq;
+
+    if (config.sameShape(_config[channel])) {
+        // Setpoint change only: the stages keep their history.
+        FilterPipelineConfig running = config.atStageRates();
+        for (size_t i = 0; i < _stageCount[channel]; ++i) _stages[i][channel]->configure(running.stages[i]);
+        _config[channel] = config;
+        LOG_FILTER_PIPELINE("FilterManager '%s' applied new setpoints", _names[channel]);
+    } else {
+        rebuildPipeline(channel, config);
+    }
+}
+
+// --- Warm start ---
+
+void FilterBank::saveState(int channel, FilterStateBlob& blob, uint32_t now) const {
+    memset(&blob, 0, sizeof(blob));
+    blob.magic = FILTER_STATE_MAGIC;
+    blob.version = FILTER_STATE_VERSION;
+    blob.piCount = (uint8_t)_piCount[channel];
+    blob.stageCount = (uint8_t)_stageCount[channel];
+    blob.savedAt = now;
+    if (_fixedPath[channel]) {
+        // The same format, so either build restores it.
+        _hfFixedFilter[channel].saveState(blob.stages[0]);
+        _lfFixedFilter[channel].saveState(blob.stages[1]);
+        return;
+    }
+    for (size_t i = 0; i < _piCount[channel]; ++i) _piFilters[i][channel]->saveState(blob.stages[i]);
+}
+
+/**
+ * @brief Restores a saved state unless it is stale: written for another
+ * pipeline, older than FILTER_STATE_MAX_AGE_S, or further than
+ * FILTER_STATE_MAX_JUMP_MV from what the probe reads now. The age check is
+ * skipped if either timestamp is 0 (clock not running).
+ * @return True if the state was restored.
+ */
+bool FilterBank::restoreState(int channel, const FilterStateBlob& blob, uint32_t now, sample_t currentValue) {
+    // A pending rebuild (e.g. a new hum notch) would otherwise discard the restored state.
+    applyPendingConfig(channel);
+    size_t piCount = _piCount[channel];
+    if (blob.magic != FILTER_STATE_MAGIC || blob.version != FILTER_STATE_VERSION) return false;
+    if (piCount == 0 || blob.piCount != piCount || blob.stageCount != _stageCount[channel]) return false;
+    for (size_t i = 0; i < piCount; ++i) {
+        if (blob.stages[i].windowSize != _piFilters[i][channel]->params.medianWindowSize) return false;
+        if (blob.stages[i].sampleCount == 0) return false;
+    }
+    if (now != 0 && blob.savedAt != 0) {
+        if (now < blob.savedAt) {
+            LOG_FILTER("FilterManager '%s': saved state is from the future (saved at %lu, now %lu), not restored",
+                       _names[channel], (unsigned long)blob.savedAt, (unsigned long)now);
+            return false;
+        }
+        if (now - blob.savedAt > FILTER_STATE_MAX_AGE_S) {
+            LOG_FILTER("FilterManager '%s': saved state is %lu s old, not restored", _names[channel], (unsigned long)(now - blob.savedAt));
+            return false;
+        }
+    }
+    sample_t savedOutput = blob.stages[piCount - 1].filteredValue;
+    if (std::isnan(currentValue) || std::fabs(currentValue - savedOutput) > FILTER_STATE_MAX_JUMP_MV) {
+        LOG_FILTER("FilterManager '%s': saved state does not match the probe, not restored", _names[channel]);
+        return false;
+    }
+    for (size_t i = 0; i < piCount; ++i) _piFilters[i][channel]->restoreState(blob.stages[i]);
+    // A Kalman stage's state is not saved; it restarts at the saved output.
+    KalmanFilter* kalman = getKalmanFilter(channel);
+    if (kalman) kalman->seed(savedOutput);
+    _fixedResync[channel] = true;
+    _lastOutput[channel] = savedOutput;
+    _stability[channel].reset();
+    LOG_FILTER("FilterManager '%s' warm-started at %.3f", _names[channel], savedOutput);
+    return true;
+}
+
+// --- KPIs and snapshots ---
+
+/**
+ * @brief --- NEW: Copies the graph history and KPIs into the triple buffer. ---
+ * This moves the history copies from the UI's frame loop to the data task,
+ * which owns the filters and can read them without tearing.
+ */
+void FilterBank::publishSnapshot(int channel) {
+    TripleBuffer<FilterSnapshot>* buffer = snapshotBuffer(channel);
+    FilterSnapshot& snapshot = buffer->back();
+    if (_fixedPath[channel]) {
+        const PI_FilterFixed& hf = _hfFixedFilter[channel];
+        const PI_FilterFixed& lf = _lfFixedFilter[channel];
+        hf.getRawHistory(snapshot.hfRaw, FILTER_HISTORY_SIZE);
+        hf.getFilteredHistory(snapshot.hfFiltered, FILTER_HISTORY_SIZE);
+        lf.getFilteredHistory(snapshot.lfFiltered, FILTER_HISTORY_SIZE);
+        snapshot.hfRawStdDev = hf.getRawStandardDeviation();
+        snapshot.hfFilteredStdDev = hf.getFilteredStandardDeviation();
+        snapshot.lfFilteredStdDev = lf.getFilteredStandardDeviation();
+        snapshot.hfStabilityPercent = hf.getStabilityPercentage();
+        snapshot.noiseReductionPercent = getFixedNoiseReductionPercentage(channel);
+        snapshot.filteredValue = _lastOutput[channel];
+        snapshot.isLocked = lf.isLocked();
+        snapshot.sequence = ++_snapshotSeq[channel];
+        buffer->publish();
+        return;
+    }
+    PI_Filter* hf = getFilter(channel, 0);
+    PI_Filter* lf = getFilter(channel, 1);
+    if (hf) {
+        hf->getRawHistory(snapshot.hfRaw, FILTER_HISTORY_SIZE);
+        hf->getFilteredHistory(snapshot.hfFiltered, FILTER_HISTORY_SIZE);
+    } else {
+        std::fill(snapshot.hfRaw, snapshot.hfRaw + FILTER_HISTORY_SIZE, 0.0);
+        std::fill(snapshot.hfFiltered, snapshot.hfFiltered + FILTER_HISTORY_SIZE, 0.0);
+    }
+    if (lf) {
+        lf->getFilteredHistory(snapshot.lfFiltered, FILTER_HISTORY_SIZE);
+    } else {
+        std::fill(snapshot.lfFiltered, snapshot.lfFiltered + FILTER_HISTORY_SIZE, 0.0);
+    }
+    snapshot.hfRawStdDev = hf ? hf->getRawStandardDeviation() : 0.0;
+    snapshot.hfFilteredStdDev = hf ? hf->getFilteredStandardDeviation() : 0.0;
+    KalmanFilter* kalman = getKalmanFilter(channel);
+    if (kalman) {
+        snapshot.lfFilteredStdDev = kalman->getStandardDeviation();
+    } else {
+        snapshot.lfFilteredStdDev = lf ? lf->getFilteredStandardDeviation() : 0.0;
+    }
+    snapshot.hfStabilityPercent = hf ? hf->getStabilityPercentage() : 0;
+    snapshot.noiseReductionPercent = getNoiseReductionPercentage(channel);
+    snapshot.filteredValue = _lastOutput[channel];
+    size_t piCount = _piCount[channel];
+    snapshot.isLocked = (piCount > 0) ? _piFilters[piCount - 1][channel]->isLocked() : true;
+    snapshot.sequence = ++_snapshotSeq[channel];
+    buffer->publish();
+}
+
+/**
+ * @brief The first call for a channel installs its triple buffer, so the
+ * fixed-point path starts publishing; until then it skips the copies.
+ */
+const FilterSnapshot* FilterBank::getSnapshot(int channel) {
+    const FilterSnapshot* snapshot = snapshotBuffer(channel)->acquire();
+    return (snapshot->sequence > 0) ? snapshot : nullptr;
+}
+
+// The channel's triple buffer, created by whichever side gets there first.
+TripleBuffer<FilterSnapshot>* FilterBank::snapshotBuffer(int channel) {
+    TripleBuffer<FilterSnapshot>* buffer = _snapshots[channel].load(std::memory_order_acquire);
+    if (buffer) return buffer;
+    TripleBuffer<FilterSnapshot>* created = new TripleBuffer<FilterSnapshot>();
+    if (_snapshots[channel].compare_exchange_strong(buffer, created, std::memory_order_acq_rel)) return created;
+    delete created;
+    return buffer;
+}
+
+/**
+ * @brief --- NEW: Implementation of the total noise reduction KPI. ---
+ * This function encapsulates the one true calculation for pipeline performance.
+ * It compares the standard deviation of the initial raw signal (from the first
+ * PI stage's perspective) to the standard deviation of the final clean signal
+ * (from the last PI stage's output).
+ * --- NEW: A Kalman stage reports its own output variance, so its std-dev
+ * replaces the last PI stage's O(n) pass. ---
+ * @version 3.1.13
+ */
+int FilterBank::getNoiseReductionPercentage(int channel) const {
+    size_t piCount = _piCount[channel];
+    KalmanFilter* kalman = getKalmanFilter(channel);
+    if (kalman) {
+        if (piCount == 0) return kalman->getNoiseReductionPercentage();
+        double raw_std = _piFilters[0][channel]->getRawStandardDeviation();
+        if (raw_std <= 1e-9) return 100;
+        double improvement = 1.0 - (kalman->getStandardDeviation() / raw_std);
+        return (int)constrain(improvement * 100.0, 0.0, 100.0);
+    }
+    if (piCount == 0) return 0;
+    double raw_std = _piFilters[0][channel]->getRawStandardDeviation();
+    double final_std = _piFilters[piCount - 1][channel]->getFilteredStandardDeviation();
+
+    if (raw_std > 1e-9) {
+        double improvement = 1.0 - (final_std / raw_std);
+        return (int)constrain(improvement * 100.0, 0.0, 100.0);
+    }
+    return 100;
+}
+
+/**
+ * @brief The total noise reduction KPI for the fixed-point pipeline.
+ */
+int FilterBank::getFixedNoiseReductionPercentage(int channel) const {
+    float raw_std = _hfFixedFilter[channel].getRawStandardDeviation();
+    float final_std = _lfFixedFilter[channel].getFilteredStandardDeviation();
+
+    if (raw_std > 0.0f) {
+        float improvement = 1.0f - (final_std / raw_std);
+        return (int)constrain(improvement * 100.0f, 0.0f, 100.0f);
+    }
+    return 100;
+}
@@ -0,0 +1,210 @@
+// File Path: /lib/FilterManager/src/FilterBank.h
+// NEW FILE
+
+#ifndef FILTER_BANK_H
+#define FILTER_BANK_H
+
+#include "PI_Filter.h"
+#include "PI_FilterFixed.h"
+#include "TripleBuffer.h"
+#include "FilterStage.h"
+#include "StabilityDetector.h"
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// The number of channels the bank holds: pH, EC and the two rail monitors.
+#ifndef FILTER_BANK_CHANNELS
+#define FILTER_BANK_CHANNELS 4
+#endif
+
+// Block size for interleaving the stages in batch processing. Small
+// enough that the intermediate block stays on the stack and in cache.
+#define FILTER_BATCH_BLOCK 32
+
+// Decimation factor between the HF and LF stages of the default pipeline.
+// 1 runs LF on every sample; N runs it on the average of every N HF outputs,
+// with its setpoints rescaled to match (see FilterParams::atDecimatedRate).
+// 4 takes about a third off the pipeline's CPU per sample. The fixed-point
+// build keeps 1: only the plain HF/LF pair has an integer twin.
+#ifndef FILTER_LF_DECIMATION
+#if PIPELINE_FIXED_POINT == 1
+#define FILTER_LF_DECIMATION 1
+#else
+#define FILTER_LF_DECIMATION 4
+#endif
+#endif
+
+/**
+ * @struct FilterSnapshot
+ * @brief --- NEW: An immutable copy of the pipeline's history and KPIs. ---
+ * Published by the data task for the live tuning graphs, so the UI never
+ * reads a filter while it is being updated.
+ */
+struct FilterSnapshot {
+    double hfRaw[FILTER_HISTORY_SIZE];
+    double hfFiltered[FILTER_HISTORY_SIZE];
+    double lfFiltered[FILTER_HISTORY_SIZE];
+    double hfRawStdDev;
+    double hfFilteredStdDev;
+    double lfFilteredStdDev;
+    int hfStabilityPercent;
+    int noiseReductionPercent;
+    double filteredValue;
+    bool isLocked;
+    uint32_t sequence; // Increments on every publish
+};
+
+// The most burst samples prime() looks at.
+#define FILTER_PRIME_MAX_SAMPLES 64
+
+// A saved filter state older than this is not restored, in seconds.
+#define FILTER_STATE_MAX_AGE_S 900
+// Nor is one whose output differs from the first live sample by more than
+// this many millivolts: the probe has been moved or has drifted meanwhile.
+#define FILTER_STATE_MAX_JUMP_MV 5.0
+
+#define FILTER_STATE_MAGIC 0x54534650u // "PFST"
+#define FILTER_STATE_VERSION 1
+
+/**
+ * @struct FilterStateBlob
+ * @brief --- NEW: One channel's runtime state in a compact binary form. ---
+ * Only the first piCount entries of 'stages' are stored; see size().
+ */
+struct FilterStateBlob {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t piCount;
+    uint8_t stageCount;
+    uint32_t savedAt; // Unix time, or 0 if the clock was not running
+    PI_FilterState stages[FILTER_MAX_STAGES];
+
+    size_t size() const { return offsetof(FilterStateBlob, stages) + piCount * sizeof(PI_FilterState); }
+};
+
+/**
+ * @class FilterBank
+ * @brief --- NEW: The filter state of every channel, in one place. ---
+ *
+ * Each per-channel field is an array indexed by channel, and the stage
+ * table is stored stage-major, so a pass over all channels walks each
+ * field contiguously. process(in, out, mask) advances every channel in the
+ * mask by one sample in that single pass. Channels whose current stage is a
+ * PI filter with a 3, 5 or 7 sample median have their medians selected
+ * together, by one sorting network running on a lane per channel.
+ *
+ * FilterManager is a view onto one channel; code outside the data path
+ * should keep using it. Channels are attached and detached at boot (or by
+ * the data task), never while another task is filtering.
+ */
+class FilterBank {
+public:
+    static FilterBank& instance();
+
+    /**
+     * @brief Takes a free channel and builds its pipeline.
+     * @param name Used in log messages; must outlive the channel.
+     * @return The channel index, or -1 if every channel is taken or the
+     * stage pool cannot supply the pipeline.
+     */
+    int attach(const char* name, const FilterPipelineConfig& config);
+    void detach(int channel);
+
+    /**
+     * @brief Data task: advances every channel in 'channelMask' by one sample.
+     * The outputs are identical to calling process(channel, in[channel]) for
+     * each of them in turn. Channels outside the mask are not touched.
+     * @param in,out Indexed by channel; only the masked entries are used.
+     */
+    void process(const sample_t* in, sample_t* out, uint32_t channelMask);
+
+    // --- Single-channel data path, behind FilterManager ---
+    sample_t process(int channel, sample_t rawVoltage);
+    void process(int channel, const sample_t* in, sample_t* out, size_t count);
+    sample_t processCounts(int channel, int16_t rawCounts, float mvPerCount);
+
+    // --- Pipeline and setpoints, behind FilterManager ---
+    bool configure(int channel, const FilterPipelineConfig& config);
+    FilterPipelineConfig getConfig(int channel) const;
+    // PI stages are addressed by role (0 = HF, 1 = LF), see FilterPipelineConfig::piStage().
+    void publishParams(int channel, int role, const FilterParams& params);
+    void publishParams(int channel, const FilterParams& hfParams, const FilterParams& lfParams);
+    FilterParams getParams(int channel, int role) const;
+    void publishKalmanParams(int channel, const KalmanParams& params);
+
+    size_t getStageCount(int channel) const { return _stageCount[channel]; }
+    FilterStage* getStage(int channel, size_t index);
+    PI_Filter* getFilter(int channel, int role) const;
+    PI_FilterFixed* getFixedFilter(int channel, int index);
+    KalmanFilter* getKalmanFilter(int channel) const;
+
+    void prime(int channel, const sample_t* samples, size_t count);
+    sample_t getOutput(int channel) const { return _lastOutput[channel]; }
+
+    // --- Warm start, behind FilterManager ---
+    void saveState(int channel, FilterStateBlob& blob, uint32_t now) const;
+    bool restoreState(int channel, const FilterStateBlob& blob, uint32_t now, sample_t currentValue);
+
+    // --- KPIs and graph snapshots, behind FilterManager ---
+    void publishSnapshot(int channel);
+    const FilterSnapshot* getSnapshot(int channel);
+    int getNoiseReductionPercentage(int channel) const;
+    int getFixedNoiseReductionPercentage(int channel) const;
+
+    // --- Stability of the pipeline output, behind FilterManager ---
+    const StabilityDetector& getStabilityDetector(int channel) const { return _stability[channel]; }
+    void setStabilityCriteria(int channel, const StabilityCriteria& criteria) { _stability[channel].setCriteria(criteria); }
+    void resetStability(int channel) { _stability[channel].reset(); }
+
+private:
+    FilterBank();
+    ~FilterBank();
+
+    void applyPendingConfig(int channel);
+    bool rebuildPipeline(int channel, const FilterPipelineConfig& config);
+    bool acquireStages(int channel, const FilterPipelineConfig& config);
+    void releaseStages(int channel);
+    void resetFixedFilters(int channel);
+    TripleBuffer<FilterSnapshot>* snapshotBuffer(int channel);
+    sample_t processSample(int channel, sample_t value);
+    uint32_t beginPublish(int channel);
+    template <int N>
+    void selectMedians(size_t stage, uint32_t lanes);
+
+    uint32_t _attached; // Bit per channel
+    const char* _names[FILTER_BANK_CHANNELS];
+
+    // The running pipelines. Only the data task touches these.
+    FilterStage* _stages[FILTER_MAX_STAGES][FILTER_BANK_CHANNELS];
+    PI_Filter* _piFilters[FILTER_MAX_STAGES][FILTER_BANK_CHANNELS];
+    size_t _stageCount[FILTER_BANK_CHANNELS];
+    size_t _piCount[FILTER_BANK_CHANNELS];
+    int _firstPiRole[FILTER_BANK_CHANNELS]; // Role of _piFilters[0]
+    sample_t _value[FILTER_BANK_CHANNELS];      // Working column of a bank pass
+    sample_t _lastOutput[FILTER_BANK_CHANNELS];
+    FilterPipelineConfig _config[FILTER_BANK_CHANNELS];
+    StabilityDetector _stability[FILTER_BANK_CHANNELS]; // Fed one output per input sample
+
+    // The fixed-point twins of a plain [pi, pi] pipeline. processCounts()
+    // runs them instead of the PI stages; prime() and restoreState() work on
+    // the PI stages and leave _fixedResync set for it to copy their state over.
+    PI_FilterFixed _hfFixedFilter[FILTER_BANK_CHANNELS];
+    PI_FilterFixed _lfFixedFilter[FILTER_BANK_CHANNELS];
+    bool _fixedPath[FILTER_BANK_CHANNELS];     // The twins hold the running state
+    bool _fixedResync[FILTER_BANK_CHANNELS];
+    bool _fixedFallbackLogged[FILTER_BANK_CHANNELS];
+
+    // The published pipelines, handed to the data task with a sequence lock.
+    // A counter is odd while a publisher is writing; the data task copies
+    // the block only when the counter is even and unchanged across the copy,
+    // and otherwise keeps its current pipeline and tries again next sample.
+    FilterPipelineConfig _publishedConfig[FILTER_BANK_CHANNELS];
+    std::atomic<uint32_t> _paramSeq[FILTER_BANK_CHANNELS];
+    uint32_t _appliedParamSeq[FILTER_BANK_CHANNELS]; // Only touched by the data task
+
+    std::atomic<TripleBuffer<FilterSnapshot>*> _snapshots[FILTER_BANK_CHANNELS];
+    uint32_t _snapshotSeq[FILTER_BANK_CHANNELS];
+};
+
+#endif // FILTER_BANK_H
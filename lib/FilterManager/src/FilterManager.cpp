@@ -4,66 +4,190 @@
 #include "FilterManager.h"
 #include "ConfigManager.h"
 #include "DebugConfig.h"
+#include <string.h>
 
 FilterManager::FilterManager() :
     _faultHandler(nullptr),
-    _initialized(false)
+    _bank(nullptr),
+    _channel(-1)
 {}
 
+FilterManager::~FilterManager() {
+    if (_bank) _bank->detach(_channel);
+}
+
 /**
- * @brief Initializes the FilterManager with hardcoded defaults.
+ * @brief Attaches to a FilterBank channel with the standard HF/LF pipeline.
  * @version 3.1.13
  */
 bool FilterManager::begin(FaultHandler& faultHandler, const char* name) {
     _faultHandler = &faultHandler;
     _name = name;
-    _hfFilter.medianWindowSize = 5;
-    _hfFilter.settleThreshold = 0.1;
-    _hfFilter.lockSmoothing = 0.1;
-    _hfFilter.trackResponse = 0.6;
-    _hfFilter.trackAssist = 0.01;
-    _lfFilter.medianWindowSize = 15;
-    _lfFilter.settleThreshold = 0.01;
-    _lfFilter.lockSmoothing = 0.005;
-    _lfFilter.trackResponse = 0.05;
-    _lfFilter.trackAssist = 0.0001;
-    _initialized = true;
-    return true;
-}
-
-double FilterManager::process(double rawVoltage) {
-    if (!_initialized) {
+    FilterParams hf;
+    hf.medianWindowSize = 5;
+    hf.settleThreshold = 0.1;
+    hf.lockSmoothing = 0.1;
+    hf.trackResponse = 0.6;
+    hf.trackAssist = 0.01;
+    FilterParams lf;
+    lf.medianWindowSize = 15;
+    lf.settleThreshold = 0.01;
+    lf.lockSmoothing = 0.005;
+    lf.trackResponse = 0.05;
+    lf.trackAssist = 0.0001;
+    // The data task is not running yet, so the pipeline is built right away.
+    if (_bank) _bank->detach(_channel);
+    _bank = &FilterBank::instance();
+    _channel = _bank->attach(_name.c_str(), FilterPipelineConfig::multirate(hf, lf, FILTER_LF_DECIMATION));
+    return _channel >= 0;
+}
+
+sample_t FilterManager::process(sample_t rawVoltage) {
+    if (_channel < 0) {
         return rawVoltage;
     }
-    LOG_FILTER_PIPELINE("FilterManager '%s' received raw value: %.4f", _name.c_str(), rawVoltage);
-    double hfFiltered = _hfFilter.process(rawVoltage);
-    LOG_FILTER_PIPELINE(" > HF Filter output: %.4f", hfFiltered);
-    double lfFiltered = _lfFilter.process(hfFiltered);
-    LOG_FILTER_PIPELINE(" > LF Filter output: %.4f", lfFiltered);
-    return lfFiltered;
+    return _bank->process(_channel, rawVoltage);
+}
+
+void FilterManager::process(const sample_t* in, sample_t* out, size_t count) {
+    if (_channel < 0) {
+        if (out != in) memcpy(out, in, count * sizeof(sample_t));
+        return;
+    }
+    _bank->process(_channel, in, out, count);
+}
+
+sample_t FilterManager::processCounts(int16_t rawCounts, float mvPerCount) {
+    if (_channel < 0) {
+        return rawCounts * mvPerCount;
+    }
+    return _bank->processCounts(_channel, rawCounts, mvPerCount);
+}
+
+sample_t FilterManager::getOutput() const {
+    return (_channel >= 0) ? _bank->getOutput(_channel) : 0.0f;
+}
+
+PI_FilterFixed* FilterManager::getFixedFilter(int index) {
+    return (_channel >= 0) ? _bank->getFixedFilter(_channel, index) : nullptr;
 }
 
 PI_Filter* FilterManager::getFilter(int index) {
-    if (index == 0) return &_hfFilter;
-    if (index == 1) return &_lfFilter;
-    return nullptr;
+    return (_channel >= 0) ? _bank->getFilter(_channel, index) : nullptr;
 }
 
-/**
- * @brief --- NEW: Implementation of the total noise reduction KPI. ---
- * This function encapsulates the one true calculation for pipeline performance.
- * It compares the standard deviation of the initial raw signal (from the HF
- * filter's perspective) to the standard deviation of the final clean signal
- * (from the LF filter's output).
- * @version 3.1.13
- */
-int FilterManager::getNoiseReductionPercentage() const {
-    double raw_std = _hfFilter.getRawStandardDeviation();
-    double final_std = _lfFilter.getFilteredStandardDeviation();
+bool FilterManager::hasPIStage(int index) const {
+    return (_channel >= 0) && _bank->getConfig(_channel).piStage(index) != nullptr;
+}
+
+size_t FilterManager::getStageCount() const {
+    return (_channel >= 0) ? _bank->getStageCount(_channel) : 0;
+}
+
+FilterStage* FilterManager::getStage(size_t index) {
+    return (_channel >= 0) ? _bank->getStage(_channel, index) : nullptr;
+}
+
+bool FilterManager::configure(const FilterPipelineConfig& config) {
+    return (_channel >= 0) && _bank->configure(_channel, config);
+}
+
+FilterPipelineConfig FilterManager::getConfig() const {
+    return (_channel >= 0) ? _bank->getConfig(_channel) : FilterPipelineConfig();
+}
+
+void FilterManager::publishParams(int index, const FilterParams& params) {
+    if (_channel >= 0) _bank->publishParams(_channel, index, params);
+}
+
+void FilterManager::publishParams(const FilterParams& hfParams, const FilterParams& lfParams) {
+    if (_channel >= 0) _bank->publishParams(_channel, hfParams, lfParams);
+}
+
+FilterParams FilterManager::getParams(int index) const {
+    return (_channel >= 0) ? _bank->getParams(_channel, index) : FilterParams();
+}
 
-    if (raw_std > 1e-9) {
-        double improvement = 1.0 - (final_std / raw_std);
-        return (int)constrain(improvement * 100.0, 0.0, 100.0);
+KalmanFilter* FilterManager::getKalmanFilter() {
+    return (_channel >= 0) ? _bank->getKalmanFilter(_channel) : nullptr;
+}
+
+void FilterManager::publishKalmanParams(const KalmanParams& params) {
+    if (_channel >= 0) _bank->publishKalmanParams(_channel, params);
+}
+
+bool FilterManager::setMainsNotch(int mainsHz, double sampleRate) {
+    FilterPipelineConfig config = getConfig();
+    int index = config.find(FilterStageType::NOTCH);
+    NotchParams notch = NotchParams::forMains(mainsHz, sampleRate);
+    if (mainsHz <= 0 || !notch.isValid()) {
+        if (index < 0) return true;
+        config.remove(index);
+    } else if (index >= 0) {
+        if (config.stages[index].notch == notch) return true;
+        config.stages[index].notch = notch;
+    } else {
+        FilterStageConfig stage;
+        stage.type = FilterStageType::NOTCH;
+        stage.notch = notch;
+        if (!config.insert(0, stage)) return false;
     }
-    return 100;
-}
\ No newline at end of file
+    LOG_FILTER("FilterManager '%s' mains notch: %d Hz", _name.c_str(), mainsHz);
+    return configure(config);
+}
+
+void FilterManager::publishSnapshot() {
+    if (_channel >= 0) _bank->publishSnapshot(_channel);
+}
+
+const FilterSnapshot* FilterManager::getSnapshot() {
+    return (_channel >= 0) ? _bank->getSnapshot(_channel) : nullptr;
+}
+
+void FilterManager::prime(const sample_t* samples, size_t count) {
+    if (_channel >= 0) _bank->prime(_channel, samples, count);
+}
+
+void FilterManager::saveState(FilterStateBlob& blob, uint32_t now) const {
+    if (_channel >= 0) {
+        _bank->saveState(_channel, blob, now);
+    } else {
+        memset(&blob, 0, sizeof(blob));
+    }
+}
+
+bool FilterManager::restoreState(const FilterStateBlob& blob, uint32_t now, sample_t currentValue) {
+    return (_channel >= 0) && _bank->restoreState(_channel, blob, now, currentValue);
+}
+
+int FilterManager::getNoiseReductionPercentage() const {
+    return (_channel >= 0) ? _bank->getNoiseReductionPercentage(_channel) : 0;
+}
+
+int FilterManager::getFixedNoiseReductionPercentage() const {
+    return (_channel >= 0) ? _bank->getFixedNoiseReductionPercentage(_channel) : 100;
+}
+
+const StabilityDetector* FilterManager::getStabilityDetector() const {
+    return (_channel >= 0) ? &_bank->getStabilityDetector(_channel) : nullptr;
+}
+
+bool FilterManager::isStable() const {
+    return (_channel >= 0) && _bank->getStabilityDetector(_channel).isStable();
+}
+
+int FilterManager::getStabilityPercentage() const {
+    return (_channel >= 0) ? _bank->getStabilityDetector(_channel).getStabilityPercentage() : 0;
+}
+
+void FilterManager::setStabilityCriteria(const StabilityCriteria& criteria) {
+    if (_channel >= 0) _bank->setStabilityCriteria(_channel, criteria);
+}
+
+void FilterManager::resetStability() {
+    if (_channel >= 0) _bank->resetStability(_channel);
+}
+
+StabilityCriteria FilterManager::getStabilityCriteria() const {
+    return (_channel >= 0) ? _bank->getStabilityDetector(_channel).getCriteria() : StabilityCriteria();
+}
@@ -5,7 +5,7 @@
 #define FILTER_MANAGER_H
 
 #include <FaultHandler.h>
-#include "PI_Filter.h"
+#include "FilterBank.h"
 #include <string>
 
 // Forward declaration to avoid circular dependency
@@ -13,16 +13,156 @@ class ConfigManager;
 
 /**
  * @class FilterManager
- * @brief Manages the two-stage (HF/LF) filtering pipeline for a single signal source.
+ * @brief Manages the filtering pipeline for a single signal source.
+ *
+ * The pipeline is a chain of up to FILTER_MAX_STAGES stages borrowed from the
+ * FilterStagePool. Every channel starts with the classic two PI stages, HF
+ * then LF; configure() replaces that with any chain of median, PI, moving
+ * average and decimator stages. The PI stages are still reached with
+ * getFilter(), by role: 0 is the first PI stage ("HF") and 1 the second
+ * ("LF"). --- NEW: A Hampel stage ahead of the first PI stage holds the HF
+ * role itself, so its pipeline has no PI stage 0 and the PI stage behind it
+ * is still 1. ---
+ *
+ * The filter state itself lives in the FilterBank; a FilterManager is a view
+ * onto one of its channels, attached by begin().
  * @version 3.1.13
  */
 class FilterManager {
 public:
     FilterManager();
+    ~FilterManager();
+    FilterManager(const FilterManager&) = delete;
+    FilterManager& operator=(const FilterManager&) = delete;
     bool begin(FaultHandler& faultHandler, const char* name);
-    double process(double rawVoltage);
+    sample_t process(sample_t rawVoltage);
+
+    /**
+     * @brief --- NEW: Batch version of process() for replays and captures. ---
+     * Produces the same outputs as calling process() once per sample. A
+     * pipeline of PI stages is run stage by stage on blocks of
+     * FILTER_BATCH_BLOCK samples, with the KPI statistics computed once per
+     * block; other pipelines are stepped one sample at a time.
+     * @param out May be the same buffer as 'in'.
+     */
+    void process(const sample_t* in, sample_t* out, size_t count);
+
+    /**
+     * @brief Gets the PI stage in a role (0 = HF, 1 = LF).
+     * @return nullptr if no PI stage has that role.
+     */
     PI_Filter* getFilter(int index);
 
+    // --- NEW: Whether the configured pipeline has a PI stage in a role. ---
+    bool hasPIStage(int index) const;
+
+    /**
+     * @brief --- NEW: Replaces the pipeline. ---
+     * Like publishParams(), this is safe from any task: the data task
+     * rebuilds the pipeline at its next sample boundary. If only PI setpoints
+     * differ from the running pipeline, the stages keep their history.
+     * @return False if the config is invalid; the pipeline is unchanged.
+     */
+    bool configure(const FilterPipelineConfig& config);
+
+    // The most recently configured pipeline, including published setpoints.
+    FilterPipelineConfig getConfig() const;
+
+    size_t getStageCount() const;
+    FilterStage* getStage(size_t index);
+
+    // --- NEW: This manager's channel in the FilterBank, or -1 before begin(). ---
+    int getChannel() const { return _channel; }
+    uint32_t getChannelMask() const { return (_channel >= 0) ? (1u << _channel) : 0u; }
+
+    /**
+     * @brief --- NEW: Publishes new setpoints for one PI stage (0 = HF, 1 = LF). ---
+     * Safe to call from any task while the data task is filtering. The call
+     * never waits on the data task; the new setpoints take effect at the next
+     * sample boundary. Use this instead of writing getFilter(i)->params once
+     * the data task is running. Ignored if no PI stage has that role.
+     */
+    void publishParams(int index, const FilterParams& params);
+
+    /**
+     * @brief Publishes both stages together, so the data task never runs a
+     * sample with the new HF setpoints and the old LF ones.
+     */
+    void publishParams(const FilterParams& hfParams, const FilterParams& lfParams);
+
+    /**
+     * @brief Gets the most recently published setpoints for a PI stage. These
+     * may be newer than the live filter's params by up to one sample.
+     */
+    FilterParams getParams(int index) const;
+
+    /**
+     * @brief --- NEW: The pipeline's Kalman stage, or nullptr if it has none. ---
+     */
+    KalmanFilter* getKalmanFilter();
+
+    /**
+     * @brief --- NEW: Publishes setpoints for the Kalman stage, as
+     * publishParams() does for PI stages. Ignored if there is none. ---
+     */
+    void publishKalmanParams(const KalmanParams& params);
+
+    /**
+     * @brief --- NEW: Adds, retunes or removes the mains hum notch. ---
+     * With 50 or 60, a notch stage for the alias of that hum at
+     * 'sampleRate' goes in front of the pipeline, so the nonlinear stages
+     * see the signal without it. With 0 the notch is taken out. Changing
+     * the pipeline's shape restarts it, so call this before prime().
+     * @return False if the pipeline has no room for the notch.
+     */
+    bool setMainsNotch(int mainsHz, double sampleRate = NOTCH_DEFAULT_SAMPLE_RATE);
+
+    /**
+     * @brief --- NEW: Data task: the latest pipeline output, whichever path
+     * or bank pass produced it. 0 before the first sample. ---
+     */
+    sample_t getOutput() const;
+
+    /**
+     * @brief --- NEW: Data task: publishes a snapshot of the current history
+     * and KPIs. ---
+     * The snapshot storage (three FilterSnapshots) is allocated on the first
+     * call, so only filters that are actually being graphed pay for it.
+     */
+    void publishSnapshot();
+
+    /**
+     * @brief UI task: the latest published snapshot, or nullptr if none has
+     * been published yet. The pointer stays valid and unchanged until the
+     * next call. There must be only one reader per FilterManager.
+     */
+    const FilterSnapshot* getSnapshot();
+
+    /**
+     * @brief --- NEW: Data task: pre-fills the pipeline from a fast burst of
+     * readings taken when the probe is activated. ---
+     * The PI stages start at the median of the burst, and the burst itself
+     * fills the median windows and KPI histories, so the output is usable at
+     * once instead of after the LF stage has climbed from zero.
+     */
+    void prime(const sample_t* samples, size_t count);
+
+    /**
+     * @brief --- NEW: Captures the runtime state of the PI stages (output,
+     * integral term, lock state and median window) for a warm start. ---
+     * Data task, or any task while the data task is not filtering.
+     * @param now Unix time for the staleness check, or 0 if unknown.
+     */
+    void saveState(FilterStateBlob& blob, uint32_t now) const;
+
+    /**
+     * @brief Data task: resumes from a saved state, unless it is stale (see
+     * FilterBank::restoreState). Call it just before the first sample.
+     * @param currentValue A live reading, to check the probe has not moved.
+     * @return True if the state was restored; otherwise the filters are untouched.
+     */
+    bool restoreState(const FilterStateBlob& blob, uint32_t now, sample_t currentValue);
+
     /**
      * @brief --- NEW: Gets the total noise reduction across the entire pipeline. ---
      * This is the definitive metric for filter performance, comparing the raw
@@ -31,13 +171,43 @@ public:
      */
     int getNoiseReductionPercentage() const;
 
+    /**
+     * @brief --- NEW: Fixed-point pipeline working directly on ADC counts. ---
+     * Runs the same HF/LF setpoints as process() through integer filters and
+     * converts to millivolts only on the way out, at the calibration boundary.
+     * Pipelines other than two PI stages fall back to process().
+     * @param rawCounts The signed ADS1118 conversion result.
+     * @param mvPerCount Millivolts per count (see AdcManager::getMilliVoltsPerCount).
+     * @return The filtered voltage in millivolts.
+     */
+    sample_t processCounts(int16_t rawCounts, float mvPerCount);
+    PI_FilterFixed* getFixedFilter(int index);
+    int getFixedNoiseReductionPercentage() const;
+
+    /**
+     * @brief --- NEW: Whether the pipeline output has stopped moving. ---
+     * Every process call feeds its output to a StabilityDetector, which fits
+     * a line through the last STABILITY_WINDOW_SIZE outputs. Stable means its
+     * slope and residual noise are within the criteria. Unlike the noise
+     * reduction KPI, this is the signal to use for deciding when to capture.
+     * @return nullptr before begin().
+     */
+    const StabilityDetector* getStabilityDetector() const;
+    bool isStable() const;
+    int getStabilityPercentage() const;
+
+    // Safe from any task; takes effect at the next sample.
+    void setStabilityCriteria(const StabilityCriteria& criteria);
+    StabilityCriteria getStabilityCriteria() const;
+
+    // Data task: starts a fresh window, e.g. when the probe changes buffer.
+    void resetStability();
+
 private:
     FaultHandler* _faultHandler;
-    bool _initialized;
     std::string _name; // Name for config file
-
-    PI_Filter _hfFilter;
-    PI_Filter _lfFilter;
+    FilterBank* _bank;
+    int _channel;
 };
 
-#endif // FILTER_MANAGER_H
\ No newline at end of file
+#endif // FILTER_MANAGER_H
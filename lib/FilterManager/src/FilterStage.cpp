@@ -0,0 +1,324 @@
+// File Path: /lib/FilterManager/src/FilterStage.cpp
+// NEW FILE
+
+#include "FilterStage.h"
+#include <cmath>
+#include <string.h>
+
+// --- Pipeline description ---
+
+bool FilterStageConfig::isValid() const {
+    switch (type) {
+        case FilterStageType::PI:
+            return params.medianWindowSize >= 1 && params.medianWindowSize <= MEDIAN_MAX_WINDOW_SIZE;
+        case FilterStageType::MEDIAN:
+            return size >= 1 && size <= MEDIAN_MAX_WINDOW_SIZE;
+        case FilterStageType::MOVING_AVERAGE:
+            return size >= 1 && size <= FILTER_MAX_AVERAGE_WINDOW;
+        case FilterStageType::DECIMATOR:
+            return size >= 1 && size <= FILTER_MAX_DECIMATION;
+        case FilterStageType::HAMPEL:
+            return size >= 3 && size <= MEDIAN_MAX_WINDOW_SIZE && threshold > 0.0f;
+        case FilterStageType::KALMAN:
+            return kalman.isValid();
+        case FilterStageType::NOTCH:
+            return notch.isValid();
+    }
+    return false;
+}
+
+bool FilterPipelineConfig::isValid() const {
+    if (stageCount < 1 || stageCount > FILTER_MAX_STAGES) return false;
+    for (size_t i = 0; i < stageCount; ++i) {
+        if (!stages[i].isValid()) return false;
+    }
+    return true;
+}
+
+bool FilterPipelineConfig::sameShape(const FilterPipelineConfig& other) const {
+    if (stageCount != other.stageCount) return false;
+    for (size_t i = 0; i < stageCount; ++i) {
+        if (stages[i].type != other.stages[i].type) return false;
+        if (stages[i].type != FilterStageType::PI && stages[i].size != other.stages[i].size) return false;
+    }
+    return true;
+}
+
+bool FilterPipelineConfig::add(const FilterStageConfig& stage) {
+    if (stageCount >= FILTER_MAX_STAGES) return false;
+    stages[stageCount++] = stage;
+    return true;
+}
+
+bool FilterPipelineConfig::insert(size_t index, const FilterStageConfig& stage) {
+    if (stageCount >= FILTER_MAX_STAGES || index > stageCount) return false;
+    for (size_t i = stageCount; i > index; --i) stages[i] = stages[i - 1];
+    stages[index] = stage;
+    stageCount++;
+    return true;
+}
+
+void FilterPipelineConfig::remove(size_t index) {
+    if (index >= stageCount) return;
+    for (size_t i = index; i + 1 < stageCount; ++i) stages[i] = stages[i + 1];
+    stageCount--;
+}
+
+FilterStageConfig* FilterPipelineConfig::piStage(int role) {
+    int index = role - firstPiRole();
+    if (index < 0) return nullptr;
+    for (size_t i = 0; i < stageCount; ++i) {
+        if (stages[i].type == FilterStageType::PI && index-- == 0) return &stages[i];
+    }
+    return nullptr;
+}
+
+const FilterStageConfig* FilterPipelineConfig::piStage(int role) const {
+    return const_cast<FilterPipelineConfig*>(this)->piStage(role);
+}
+
+int FilterPipelineConfig::firstPiRole() const {
+    for (size_t i = 0; i < stageCount; ++i) {
+        if (stages[i].type == FilterStageType::PI) return 0;
+        if (stages[i].type == FilterStageType::HAMPEL) return 1;
+    }
+    return 0;
+}
+
+FilterStageConfig* FilterPipelineConfig::kalmanStage() {
+    for (size_t i = 0; i < stageCount; ++i) {
+        if (stages[i].type == FilterStageType::KALMAN) return &stages[i];
+    }
+    return nullptr;
+}
+
+const FilterStageConfig* FilterPipelineConfig::kalmanStage() const {
+    return const_cast<FilterPipelineConfig*>(this)->kalmanStage();
+}
+
+int FilterPipelineConfig::find(FilterStageType type) const {
+    for (size_t i = 0; i < stageCount; ++i) {
+        if (stages[i].type == type) return (int)i;
+    }
+    return -1;
+}
+
+FilterPipelineConfig FilterPipelineConfig::atStageRates() const {
+    FilterPipelineConfig config = *this;
+    int factor = 1;
+    for (size_t i = 0; i < stageCount; ++i) {
+        if (stages[i].type == FilterStageType::PI) {
+            config.stages[i].params = stages[i].params.atDecimatedRate(factor);
+        } else if (stages[i].type == FilterStageType::KALMAN) {
+            config.stages[i].kalman = stages[i].kalman.atDecimatedRate(factor);
+        } else if (stages[i].type == FilterStageType::NOTCH) {
+            config.stages[i].notch = stages[i].notch.atDecimatedRate(factor);
+        } else if (stages[i].type == FilterStageType::DECIMATOR) {
+            factor *= stages[i].size;
+        }
+    }
+    return config;
+}
+
+FilterPipelineConfig FilterPipelineConfig::standard(const FilterParams& hfParams, const FilterParams& lfParams) {
+    FilterPipelineConfig config;
+    FilterStageConfig stage;
+    stage.type = FilterStageType::PI;
+    stage.params = hfParams;
+    config.add(stage);
+    stage.params = lfParams;
+    config.add(stage);
+    return config;
+}
+
+FilterPipelineConfig FilterPipelineConfig::multirate(const FilterParams& hfParams, const FilterParams& lfParams, int factor) {
+    if (factor <= 1) return standard(hfParams, lfParams);
+    FilterPipelineConfig config;
+    FilterStageConfig stage;
+    stage.type = FilterStageType::PI;
+    stage.params = hfParams;
+    config.add(stage);
+    FilterStageConfig decimator;
+    decimator.type = FilterStageType::DECIMATOR;
+    decimator.size = factor;
+    config.add(decimator);
+    stage.params = lfParams;
+    config.add(stage);
+    return config;
+}
+
+FilterPipelineConfig FilterPipelineConfig::hampel(int window, float threshold, const FilterParams& lfParams) {
+    FilterPipelineConfig config;
+    FilterStageConfig stage;
+    stage.type = FilterStageType::HAMPEL;
+    stage.size = window;
+    stage.threshold = threshold;
+    config.add(stage);
+    FilterStageConfig lf;
+    lf.type = FilterStageType::PI;
+    lf.params = lfParams;
+    config.add(lf);
+    return config;
+}
+
+FilterPipelineConfig FilterPipelineConfig::kalman(const FilterParams& hfParams, const KalmanParams& kalmanParams) {
+    FilterPipelineConfig config;
+    FilterStageConfig hf;
+    hf.type = FilterStageType::PI;
+    hf.params = hfParams;
+    config.add(hf);
+    FilterStageConfig stage;
+    stage.type = FilterStageType::KALMAN;
+    stage.kalman = kalmanParams;
+    config.add(stage);
+    return config;
+}
+
+const char* filterStageTypeName(FilterStageType type) {
+    switch (type) {
+        case FilterStageType::MEDIAN:         return "median";
+        case FilterStageType::PI:             return "pi";
+        case FilterStageType::MOVING_AVERAGE: return "moving_average";
+        case FilterStageType::DECIMATOR:      return "decimator";
+        case FilterStageType::HAMPEL:         return "hampel";
+        case FilterStageType::KALMAN:         return "kalman";
+        case FilterStageType::NOTCH:          return "notch";
+    }
+    return "unknown";
+}
+
+bool filterStageTypeFromName(const char* name, FilterStageType& type) {
+    if (!name) return false;
+    static const FilterStageType types[] = {
+        FilterStageType::MEDIAN, FilterStageType::PI,
+        FilterStageType::MOVING_AVERAGE, FilterStageType::DECIMATOR,
+        FilterStageType::HAMPEL, FilterStageType::KALMAN,
+        FilterStageType::NOTCH
+    };
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i) {
+        if (strcmp(name, filterStageTypeName(types[i])) == 0) {
+            type = types[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- Stages ---
+
+size_t FilterStage::process(const sample_t* in, sample_t* out, size_t count) {
+    size_t produced = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sample_t value;
+        if (process(in[i], value)) out[produced++] = value;
+    }
+    return produced;
+}
+
+bool PIStage::process(sample_t in, sample_t& out) {
+    switch (_filter.params.medianWindowSize) {
+        case 3:  out = _filter.processWindow<3>(in); break;
+        case 5:  out = _filter.processWindow<5>(in); break;
+        case 7:  out = _filter.processWindow<7>(in); break;
+        default: out = _filter.process(in); break;
+    }
+    return true;
+}
+
+size_t PIStage::process(const sample_t* in, sample_t* out, size_t count) {
+    switch (_filter.params.medianWindowSize) {
+        case 3:  _filter.processWindow<3>(in, out, count); break;
+        case 5:  _filter.processWindow<5>(in, out, count); break;
+        case 7:  _filter.processWindow<7>(in, out, count); break;
+        default: _filter.process(in, out, count); break;
+    }
+    return count;
+}
+
+void MedianStage::configure(const FilterStageConfig& config) {
+    if (config.size != _median.getWindowSize()) {
+        _median.clear();
+        _median.setWindowSize(config.size);
+    }
+}
+
+bool MedianStage::process(sample_t in, sample_t& out) {
+    if (std::isnan(in)) return false;
+    out = _median.push(in);
+    return true;
+}
+
+void HampelStage::configure(const FilterStageConfig& config) {
+    if (config.size != _filter.getWindowSize()) {
+        _filter.clear();
+        _filter.setWindowSize(config.size);
+    }
+    _filter.setThreshold(config.threshold);
+}
+
+bool HampelStage::process(sample_t in, sample_t& out) {
+    if (std::isnan(in)) return false;
+    switch (_filter.getWindowSize()) {
+        case 3:  out = _filter.processWindow<3>(in); break;
+        case 5:  out = _filter.processWindow<5>(in); break;
+        case 7:  out = _filter.processWindow<7>(in); break;
+        default: out = _filter.process(in); break;
+    }
+    return true;
+}
+
+bool KalmanStage::process(sample_t in, sample_t& out) {
+    if (std::isnan(in)) return false;
+    out = _filter.process(in);
+    return true;
+}
+
+bool NotchStage::process(sample_t in, sample_t& out) {
+    if (std::isnan(in)) return false;
+    out = _filter.process(in);
+    return true;
+}
+
+void MovingAverageStage::configure(const FilterStageConfig& config) {
+    if (config.size != _window) {
+        _window = config.size;
+        reset();
+    }
+}
+
+bool MovingAverageStage::process(sample_t in, sample_t& out) {
+    if (std::isnan(in)) return false;
+    if (_count == _window) {
+        _sum -= _samples[_head];
+    } else {
+        _count++;
+    }
+    _samples[_head] = in;
+    _sum += in;
+    _head = (_head + 1) % _window;
+    // Re-add the window from scratch once per lap, so rounding in the
+    // running sum cannot build up over a long session.
+    if (_head == 0) {
+        _sum = 0.0;
+        for (int i = 0; i < _count; ++i) _sum += _samples[i];
+    }
+    out = (sample_t)(_sum / _count);
+    return true;
+}
+
+void DecimatorStage::configure(const FilterStageConfig& config) {
+    if (config.size != _factor) {
+        _factor = config.size;
+        reset();
+    }
+}
+
+bool DecimatorStage::process(sample_t in, sample_t& out) {
+    if (std::isnan(in)) return false;
+    _sum += in;
+    if (++_count < _factor) return false;
+    out = (sample_t)(_sum / _factor);
+    _count = 0;
+    _sum = 0.0;
+    return true;
+}
@@ -0,0 +1,279 @@
+// File Path: /lib/FilterManager/src/FilterStage.h
+// NEW FILE
+
+#ifndef FILTER_STAGE_H
+#define FILTER_STAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "PI_Filter.h"
+#include "StreamingMedian.h"
+#include "HampelFilter.h"
+#include "KalmanFilter.h"
+#include "NotchFilter.h"
+
+// The most stages a single FilterManager pipeline may chain together.
+#define FILTER_MAX_STAGES 4
+// The largest moving-average window. Storage is sized for it at compile time.
+#define FILTER_MAX_AVERAGE_WINDOW 32
+// The largest decimation factor a decimator stage accepts.
+#define FILTER_MAX_DECIMATION 64
+
+enum class FilterStageType : uint8_t {
+    MEDIAN,
+    PI,
+    MOVING_AVERAGE,
+    DECIMATOR,
+    HAMPEL,
+    KALMAN,
+    NOTCH
+};
+
+/**
+ * @struct FilterStageConfig
+ * @brief Describes one stage of a pipeline.
+ */
+struct FilterStageConfig {
+    FilterStageType type = FilterStageType::PI;
+    int size = 1;        // Median/Hampel/moving-average window, or decimation factor
+    FilterParams params; // PI stages only
+    float threshold = HAMPEL_DEFAULT_THRESHOLD; // Hampel stages only, in scaled MADs
+    KalmanParams kalman; // Kalman stages only
+    NotchParams notch;   // Notch stages only
+
+    bool isValid() const;
+    bool operator==(const FilterStageConfig& other) const {
+        return type == other.type && size == other.size && params == other.params &&
+               threshold == other.threshold && kalman == other.kalman && notch == other.notch;
+    }
+};
+
+/**
+ * @struct FilterPipelineConfig
+ * @brief An ordered list of stages, as stored in the per-channel JSON config.
+ * Plain and trivially copyable so it can be published like FilterParams.
+ */
+struct FilterPipelineConfig {
+    size_t stageCount = 0;
+    FilterStageConfig stages[FILTER_MAX_STAGES];
+
+    bool isValid() const;
+    // True if both pipelines have the same stages, ignoring the PI setpoints.
+    bool sameShape(const FilterPipelineConfig& other) const;
+    bool add(const FilterStageConfig& stage);
+    // --- NEW: Inserts before 'index' (stageCount appends); false if full. ---
+    bool insert(size_t index, const FilterStageConfig& stage);
+    void remove(size_t index);
+
+    /**
+     * @brief The PI stage in a role (0 = HF, 1 = LF), or nullptr.
+     * --- NEW: A Hampel stage ahead of the first PI stage holds the HF role,
+     * so the PI stages then start at LF. ---
+     */
+    FilterStageConfig* piStage(int role);
+    const FilterStageConfig* piStage(int role) const;
+
+    // --- NEW: The role of the first PI stage: 1 behind a Hampel stage, else 0. ---
+    int firstPiRole() const;
+
+    /**
+     * @brief --- NEW: The configs the stages actually run with. ---
+     * PI setpoints are stored at the acquisition rate; a PI stage behind
+     * decimators is given them rescaled by the combined decimation factor.
+     */
+    FilterPipelineConfig atStageRates() const;
+
+    // The classic two-stage HF/LF pipeline every channel starts with.
+    static FilterPipelineConfig standard(const FilterParams& hfParams, const FilterParams& lfParams);
+
+    /**
+     * @brief --- NEW: HF at the acquisition rate, then an averaging
+     * decimator, then LF on every 'factor'-th sample. ---
+     * With factor <= 1 this is the standard pipeline.
+     */
+    static FilterPipelineConfig multirate(const FilterParams& hfParams, const FilterParams& lfParams, int factor);
+
+    /**
+     * @brief --- NEW: A Hampel stage in place of the HF stage, then LF. ---
+     * The LF stage keeps its role, 1; there is no PI stage in role 0.
+     */
+    static FilterPipelineConfig hampel(int window, float threshold, const FilterParams& lfParams);
+
+    /**
+     * @brief --- NEW: The HF stage, then a Kalman stage in place of LF. ---
+     */
+    static FilterPipelineConfig kalman(const FilterParams& hfParams, const KalmanParams& kalmanParams);
+
+    // The first Kalman stage, or nullptr.
+    FilterStageConfig* kalmanStage();
+    const FilterStageConfig* kalmanStage() const;
+
+    // The index of the first stage of 'type', or -1.
+    int find(FilterStageType type) const;
+};
+
+const char* filterStageTypeName(FilterStageType type);
+bool filterStageTypeFromName(const char* name, FilterStageType& type);
+
+/**
+ * @class FilterStage
+ * @brief One pluggable processing step in a FilterManager pipeline.
+ *
+ * Stages are taken from the FilterStagePool, never created on the fly.
+ * A stage may produce no output for a given input (a decimator does this
+ * for all but every Nth sample), in which case the rest of the pipeline
+ * is skipped for that sample.
+ */
+class FilterStage {
+public:
+    virtual ~FilterStage() {}
+
+    virtual FilterStageType getType() const = 0;
+
+    /**
+     * @brief Applies a config of this stage's type. Changing a window or
+     * factor restarts the stage; changing only PI setpoints does not.
+     */
+    virtual void configure(const FilterStageConfig& config) = 0;
+    virtual void reset() = 0;
+
+    /**
+     * @brief Processes one sample.
+     * @return True if 'out' holds a new output for the next stage.
+     */
+    virtual bool process(sample_t in, sample_t& out) = 0;
+
+    /**
+     * @brief Processes a block of samples. Outputs are packed at the front
+     * of 'out', which may be the same buffer as 'in'.
+     * @return The number of outputs written.
+     */
+    virtual size_t process(const sample_t* in, sample_t* out, size_t count);
+
+    // The PI filter behind this stage, or nullptr for other stage types.
+    virtual PI_Filter* getPIFilter() { return nullptr; }
+    // The same for Kalman stages.
+    virtual KalmanFilter* getKalmanFilter() { return nullptr; }
+};
+
+/**
+ * @class PIStage
+ * @brief The PI filter as a stage. Known median windows are stepped through
+ * the compile-time kernels, exactly as FilterManager did for HF/LF.
+ */
+class PIStage : public FilterStage {
+public:
+    FilterStageType getType() const override { return FilterStageType::PI; }
+    void configure(const FilterStageConfig& config) override { _filter.params = config.params; }
+    void reset() override { _filter.reset(); }
+    bool process(sample_t in, sample_t& out) override;
+    size_t process(const sample_t* in, sample_t* out, size_t count) override;
+    PI_Filter* getPIFilter() override { return &_filter; }
+
+private:
+    PI_Filter _filter;
+};
+
+/**
+ * @class MedianStage
+ * @brief A plain sliding-window median, for spike rejection without PI smoothing.
+ */
+class MedianStage : public FilterStage {
+public:
+    FilterStageType getType() const override { return FilterStageType::MEDIAN; }
+    void configure(const FilterStageConfig& config) override;
+    void reset() override { _median.clear(); }
+    bool process(sample_t in, sample_t& out) override;
+
+private:
+    BasicStreamingMedian<sample_t> _median;
+};
+
+/**
+ * @class HampelStage
+ * @brief --- NEW: Outlier replacement; clean samples pass through untouched. ---
+ * A cheaper spike scraper than a PI stage when the signal is mostly clean.
+ * Known windows use the selection networks, as in PIStage.
+ */
+class HampelStage : public FilterStage {
+public:
+    FilterStageType getType() const override { return FilterStageType::HAMPEL; }
+    void configure(const FilterStageConfig& config) override;
+    void reset() override { _filter.clear(); }
+    bool process(sample_t in, sample_t& out) override;
+
+private:
+    HampelFilter _filter;
+};
+
+/**
+ * @class KalmanStage
+ * @brief --- NEW: The scalar Kalman filter as a stage, for the LF position. ---
+ */
+class KalmanStage : public FilterStage {
+public:
+    FilterStageType getType() const override { return FilterStageType::KALMAN; }
+    void configure(const FilterStageConfig& config) override { _filter.params = config.kalman; }
+    void reset() override { _filter.reset(); }
+    bool process(sample_t in, sample_t& out) override;
+    KalmanFilter* getKalmanFilter() override { return &_filter; }
+
+private:
+    KalmanFilter _filter;
+};
+
+/**
+ * @class NotchStage
+ * @brief --- NEW: A biquad notch, for the alias of mains hum. ---
+ */
+class NotchStage : public FilterStage {
+public:
+    FilterStageType getType() const override { return FilterStageType::NOTCH; }
+    void configure(const FilterStageConfig& config) override { _filter.setParams(config.notch); }
+    void reset() override { _filter.reset(); }
+    bool process(sample_t in, sample_t& out) override;
+
+private:
+    NotchFilter _filter;
+};
+
+/**
+ * @class MovingAverageStage
+ * @brief A boxcar average over the last N samples with a running sum.
+ */
+class MovingAverageStage : public FilterStage {
+public:
+    MovingAverageStage() : _window(1), _head(0), _count(0), _sum(0.0) {}
+    FilterStageType getType() const override { return FilterStageType::MOVING_AVERAGE; }
+    void configure(const FilterStageConfig& config) override;
+    void reset() override { _head = 0; _count = 0; _sum = 0.0; }
+    bool process(sample_t in, sample_t& out) override;
+
+private:
+    sample_t _samples[FILTER_MAX_AVERAGE_WINDOW];
+    int _window;
+    int _head;  // Next slot to write; the oldest sample once the window is full
+    int _count;
+    double _sum;
+};
+
+/**
+ * @class DecimatorStage
+ * @brief Averages each group of N input samples into one output, so the
+ * stages after it run at 1/N of the input rate.
+ */
+class DecimatorStage : public FilterStage {
+public:
+    DecimatorStage() : _factor(1), _count(0), _sum(0.0) {}
+    FilterStageType getType() const override { return FilterStageType::DECIMATOR; }
+    void configure(const FilterStageConfig& config) override;
+    void reset() override { _count = 0; _sum = 0.0; }
+    bool process(sample_t in, sample_t& out) override;
+
+private:
+    int _factor;
+    int _count;
+    double _sum;
+};
+
+#endif // FILTER_STAGE_H
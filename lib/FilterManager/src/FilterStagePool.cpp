@@ -0,0 +1,92 @@
+// File Path: /lib/FilterManager/src/FilterStagePool.cpp
+// NEW FILE
+
+#include "FilterStagePool.h"
+
+template <typename Stage, size_t N>
+FilterStage* FilterStagePool::Slots<Stage, N>::acquire() {
+    for (size_t i = 0; i < N; ++i) {
+        if (!inUse[i]) {
+            inUse[i] = true;
+            return &stages[i];
+        }
+    }
+    return nullptr;
+}
+
+template <typename Stage, size_t N>
+bool FilterStagePool::Slots<Stage, N>::release(FilterStage* stage) {
+    for (size_t i = 0; i < N; ++i) {
+        if (stage == &stages[i]) {
+            inUse[i] = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Stage, size_t N>
+size_t FilterStagePool::Slots<Stage, N>::available() const {
+    size_t count = 0;
+    for (size_t i = 0; i < N; ++i) {
+        if (!inUse[i]) count++;
+    }
+    return count;
+}
+
+FilterStagePool& FilterStagePool::instance() {
+    static FilterStagePool pool;
+    return pool;
+}
+
+FilterStagePool::FilterStagePool() {
+    for (size_t i = 0; i < FILTER_POOL_PI_STAGES; ++i) _pi.inUse[i] = false;
+    for (size_t i = 0; i < FILTER_POOL_MEDIAN_STAGES; ++i) _median.inUse[i] = false;
+    for (size_t i = 0; i < FILTER_POOL_AVERAGE_STAGES; ++i) _average.inUse[i] = false;
+    for (size_t i = 0; i < FILTER_POOL_DECIMATOR_STAGES; ++i) _decimator.inUse[i] = false;
+    for (size_t i = 0; i < FILTER_POOL_HAMPEL_STAGES; ++i) _hampel.inUse[i] = false;
+    for (size_t i = 0; i < FILTER_POOL_KALMAN_STAGES; ++i) _kalman.inUse[i] = false;
+    for (size_t i = 0; i < FILTER_POOL_NOTCH_STAGES; ++i) _notch.inUse[i] = false;
+}
+
+FilterStage* FilterStagePool::acquire(const FilterStageConfig& config) {
+    FilterStage* stage = nullptr;
+    switch (config.type) {
+        case FilterStageType::PI:             stage = _pi.acquire(); break;
+        case FilterStageType::MEDIAN:         stage = _median.acquire(); break;
+        case FilterStageType::MOVING_AVERAGE: stage = _average.acquire(); break;
+        case FilterStageType::DECIMATOR:      stage = _decimator.acquire(); break;
+        case FilterStageType::HAMPEL:         stage = _hampel.acquire(); break;
+        case FilterStageType::KALMAN:         stage = _kalman.acquire(); break;
+        case FilterStageType::NOTCH:          stage = _notch.acquire(); break;
+    }
+    if (stage) {
+        stage->configure(config);
+        stage->reset();
+    }
+    return stage;
+}
+
+void FilterStagePool::release(FilterStage* stage) {
+    if (!stage) return;
+    if (_pi.release(stage)) return;
+    if (_median.release(stage)) return;
+    if (_average.release(stage)) return;
+    if (_decimator.release(stage)) return;
+    if (_hampel.release(stage)) return;
+    if (_kalman.release(stage)) return;
+    _notch.release(stage);
+}
+
+size_t FilterStagePool::available(FilterStageType type) const {
+    switch (type) {
+        case FilterStageType::PI:             return _pi.available();
+        case FilterStageType::MEDIAN:         return _median.available();
+        case FilterStageType::MOVING_AVERAGE: return _average.available();
+        case FilterStageType::DECIMATOR:      return _decimator.available();
+        case FilterStageType::HAMPEL:         return _hampel.available();
+        case FilterStageType::KALMAN:         return _kalman.available();
+        case FilterStageType::NOTCH:          return _notch.available();
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+// File Path: /lib/FilterManager/src/FilterStagePool.h
+// NEW FILE
+
+#ifndef FILTER_STAGE_POOL_H
+#define FILTER_STAGE_POOL_H
+
+#include "FilterStage.h"
+
+// Pool capacities. The defaults cover four channels running the standard
+// HF/LF pipeline; builds that give the rail monitors a cheaper pipeline can
+// shrink FILTER_POOL_PI_STAGES, the only large stage type.
+#ifndef FILTER_POOL_PI_STAGES
+#define FILTER_POOL_PI_STAGES 8
+#endif
+#ifndef FILTER_POOL_MEDIAN_STAGES
+#define FILTER_POOL_MEDIAN_STAGES 4
+#endif
+#ifndef FILTER_POOL_AVERAGE_STAGES
+#define FILTER_POOL_AVERAGE_STAGES 4
+#endif
+#ifndef FILTER_POOL_DECIMATOR_STAGES
+#define FILTER_POOL_DECIMATOR_STAGES 4
+#endif
+#ifndef FILTER_POOL_HAMPEL_STAGES
+#define FILTER_POOL_HAMPEL_STAGES 4
+#endif
+#ifndef FILTER_POOL_KALMAN_STAGES
+#define FILTER_POOL_KALMAN_STAGES 4
+#endif
+#ifndef FILTER_POOL_NOTCH_STAGES
+#define FILTER_POOL_NOTCH_STAGES 4
+#endif
+
+/**
+ * @class FilterStagePool
+ * @brief Statically allocated storage for every filter stage in the system.
+ *
+ * Pipelines borrow stages from here instead of allocating them, so a
+ * reconfiguration never touches the heap and memory use is fixed at build
+ * time. Acquire and release are only called while building a pipeline: at
+ * boot, or from the data task at a sample boundary.
+ */
+class FilterStagePool {
+public:
+    static FilterStagePool& instance();
+
+    /**
+     * @brief Takes a free stage of the given type, reset and configured.
+     * @return nullptr if every stage of that type is in use.
+     */
+    FilterStage* acquire(const FilterStageConfig& config);
+    void release(FilterStage* stage);
+
+    size_t available(FilterStageType type) const;
+
+private:
+    FilterStagePool();
+
+    template <typename Stage, size_t N>
+    struct Slots {
+        Stage stages[N];
+        bool inUse[N];
+        FilterStage* acquire();
+        bool release(FilterStage* stage);
+        size_t available() const;
+    };
+
+    Slots<PIStage, FILTER_POOL_PI_STAGES> _pi;
+    Slots<MedianStage, FILTER_POOL_MEDIAN_STAGES> _median;
+    Slots<MovingAverageStage, FILTER_POOL_AVERAGE_STAGES> _average;
+    Slots<DecimatorStage, FILTER_POOL_DECIMATOR_STAGES> _decimator;
+    Slots<HampelStage, FILTER_POOL_HAMPEL_STAGES> _hampel;
+    Slots<KalmanStage, FILTER_POOL_KALMAN_STAGES> _kalman;
+    Slots<NotchStage, FILTER_POOL_NOTCH_STAGES> _notch;
+};
+
+#endif // FILTER_STAGE_POOL_H
@@ -0,0 +1,57 @@
+// File Path: /lib/FilterManager/src/TripleBuffer.h
+// NEW FILE
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @class TripleBuffer
+ * @brief Lock-free hand-over of a large value from one writer to one reader.
+ *
+ * There are three slots. The writer owns one, the reader owns another, and
+ * the third is the latest published value. publish() and acquire() each swap
+ * their slot with the published one in a single atomic exchange, so neither
+ * side ever waits and the reader never sees a half-written value. A reader
+ * slower than the writer simply skips the values it did not get to.
+ *
+ * Exactly one task may call back()/publish(), and exactly one task may call
+ * acquire().
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : _slots(), _back(0), _middle(1), _front(2) {}
+
+    // Writer: the slot to fill before the next publish().
+    T& back() { return _slots[_back]; }
+
+    // Writer: makes back() the latest value and takes a free slot in return.
+    void publish() {
+        _back = _middle.exchange(_back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * @brief Reader: returns the latest published value. The pointer stays
+     * valid, and unchanged, until the reader's next acquire().
+     */
+    const T* acquire() {
+        if (_middle.load(std::memory_order_relaxed) & FRESH) {
+            _front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+        return &_slots[_front];
+    }
+
+private:
+    static const uint8_t INDEX_MASK = 0x03;
+    static const uint8_t FRESH = 0x04; // Set when the middle slot has not been read
+
+    T _slots[3];
+    uint8_t _back;                // Writer only
+    std::atomic<uint8_t> _middle; // Shared
+    uint8_t _front;               // Reader only
+};
+
+#endif // TRIPLE_BUFFER_H
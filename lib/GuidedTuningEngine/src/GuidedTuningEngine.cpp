@@ -2,6 +2,7 @@
 // MODIFIED FILE
 
 #include "GuidedTuningEngine.h"
+#include "TuningRefinement.h"
 #include "../../src/DebugConfig.h" // For LOG_AUTO_TUNE
 #include <Arduino.h>
 #include <cmath>
@@ -9,8 +10,6 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
-const float TUNING_LEARNING_RATE = 0.4f;
-
 // Helper function for mapping values (used in heuristics)
 double map_double(double x, double in_min, double in_max, double out_min, double out_max) {
     if (in_max - in_min == 0) return out_min;
@@ -21,8 +20,9 @@ GuidedTuningEngine::GuidedTuningEngine() {
     // Constructor allocates memory for FFT on the heap
     _fftReal = new double[GT_SAMPLE_COUNT];
     _fftImag = new double[GT_SAMPLE_COUNT];
-    // --- DEFINITIVE FIX: The FFT sample rate is now correctly calculated from the stable 22ms delay ---
-    _FFT = new arduinoFFT(_fftReal, _fftImag, GT_SAMPLE_COUNT, (1000.0/22.0));
+    // Replaced with the measured rate by each capture.
+    _fftSampleRate = 1e6 / ACQ_DEFAULT_PERIOD_US;
+    _FFT = new arduinoFFT(_fftReal, _fftImag, GT_SAMPLE_COUNT, _fftSampleRate);
 }
 
 GuidedTuningEngine::~GuidedTuningEngine() {
@@ -35,11 +35,11 @@ GuidedTuningEngine::~GuidedTuningEngine() {
 /**
  * @brief The master function that orchestrates the robust, RAM-based tuning process.
  */
-bool GuidedTuningEngine::proposeSettings(PBiosContext& context, AdcManager& adcManager, SdManager& sdManager, StateManager* stateManager, AutoTuningScreen& progressScreen) {
+bool GuidedTuningEngine::proposeSettings(PBiosContext& context, AcquisitionManager& acquisition, SdManager& sdManager, StateManager* stateManager, AutoTuningScreen& progressScreen) {
     if (!context.selectedFilter) return false;
 
     // --- Stage 1: Multi-Pass RAM Capture & Averaging ---
-    if (!captureSignal(context, adcManager, progressScreen)) {
+    if (!captureSignal(context, acquisition, progressScreen)) {
         LOG_AUTO_TUNE("Failed to capture signal.");
         return false;
     }
@@ -65,26 +65,41 @@ bool GuidedTuningEngine::proposeSettings(PBiosContext& context, AdcManager& adcM
  * This function performs three separate, short captures directly into RAM and
  * averages them to create a high-confidence, statistically robust signal profile.
  */
-bool GuidedTuningEngine::captureSignal(PBiosContext& context, AdcManager& adcManager, AutoTuningScreen& progressScreen) {
+bool GuidedTuningEngine::captureSignal(PBiosContext& context, AcquisitionManager& acquisition, AutoTuningScreen& progressScreen) {
     const int num_captures = 3;
     const int samples_per_capture = GT_SAMPLE_COUNT;
-    std::vector<double> averaged_samples(samples_per_capture, 0.0);
+    std::vector<sample_t> averaged_samples(samples_per_capture, 0.0f);
+    // --- NEW: The samples come from the acquisition task's fixed grid, and
+    // the FFT is given the rate they were actually taken at. ---
+    static sample_t pass[GT_SAMPLE_COUNT];
+    static uint32_t times[GT_SAMPLE_COUNT];
+    double rateSum = 0.0;
 
     for (int c = 0; c < num_captures; ++c) {
         char progress_label[40];
         snprintf(progress_label, sizeof(progress_label), "Sampling Pass (%d/%d)...", c + 1, num_captures);
         progressScreen.setProgress(10 * (c + 1), progress_label);
 
-        for (int i = 0; i < samples_per_capture; ++i) {
-            double voltage = adcManager.getVoltage(context.selectedAdcIndex, context.selectedAdcInput);
-            if(isnan(voltage)) voltage = 0;
-            averaged_samples[i] += voltage;
-            // --- DEFINITIVE FIX: Use consistent, stable timing ---
-            // This delay now matches the proven stable tempo from the other
-            // diagnostic screens, resolving the RTOS task starvation that
-            // caused the UI to freeze during auto-tuning.
+        // Each pass follows the sample bus on a cursor of its own, from now.
+        SampleCursor cursor = acquisition.subscribe();
+        int taken = 0;
+        uint32_t lastSample = millis();
+        while (taken < samples_per_capture) {
+            size_t got = acquisition.read(cursor, context.selectedAdcIndex, pass + taken, samples_per_capture - taken, times + taken);
+            if (got > 0) {
+                taken += got;
+                lastSample = millis();
+            } else if (millis() - lastSample > 1000) {
+                LOG_AUTO_TUNE("No samples from ADC%d.", context.selectedAdcIndex + 1);
+                return false;
+            }
+            // Yields to the UI task while the ring fills.
             vTaskDelay(pdMS_TO_TICKS(22));
         }
+        for (int i = 0; i < samples_per_capture; ++i) {
+            averaged_samples[i] += pass[i];
+        }
+        rateSum += acquisition.measuredRate(times, samples_per_capture);
     }
 
     // Finalize the average
@@ -94,6 +109,13 @@ bool GuidedTuningEngine::captureSignal(PBiosContext& context, AdcManager& adcMan
 
     context.captured_samples = averaged_samples;
 
+    double sampleRate = rateSum / num_captures;
+    if (sampleRate != _fftSampleRate) {
+        delete _FFT;
+        _fftSampleRate = sampleRate;
+        _FFT = new arduinoFFT(_fftReal, _fftImag, GT_SAMPLE_COUNT, _fftSampleRate);
+    }
+
     bool success = (context.captured_samples.size() == samples_per_capture);
     LOG_AUTO_TUNE("RAM Signal capture complete. Success: %d", success);
     return success;
@@ -102,14 +124,15 @@ bool GuidedTuningEngine::captureSignal(PBiosContext& context, AdcManager& adcMan
 /**
  * @brief Analyzes the captured signal to determine its key characteristics.
  */
-void GuidedTuningEngine::analyzeSignal(PBiosContext& context, const std::vector<double>& signal_to_analyze) {
+void GuidedTuningEngine::analyzeSignal(PBiosContext& context, const std::vector<sample_t>& signal_to_analyze) {
     if (signal_to_analyze.empty()) return;
     size_t sample_count = signal_to_analyze.size();
 
-    double sum = 0.0;
+    sample_t sum = 0.0f;
     for (const auto& sample : signal_to_analyze) sum += sample;
-    double mean = sum / sample_count;
+    sample_t mean = sum / sample_count;
 
+    // The FFT buffers stay double: arduinoFFT 1.x has no single-precision build.
     double sumSqDiff = 0.0;
     for (int i = 0; i < std::min((int)sample_count, GT_SAMPLE_COUNT); ++i) {
         _fftReal[i] = signal_to_analyze[i] - mean;
@@ -118,8 +141,8 @@ void GuidedTuningEngine::analyzeSignal(PBiosContext& context, const std::vector<
     }
     context.raw_std_dev = sqrt(sumSqDiff / std::min((int)sample_count, GT_SAMPLE_COUNT));
 
-    double min_val = *std::min_element(signal_to_analyze.begin(), signal_to_analyze.end());
-    double max_val = *std::max_element(signal_to_analyze.begin(), signal_to_analyze.end());
+    sample_t min_val = *std::min_element(signal_to_analyze.begin(), signal_to_analyze.end());
+    sample_t max_val = *std::max_element(signal_to_analyze.begin(), signal_to_analyze.end());
     context.pk_pk_amplitude = max_val - min_val;
 
     _FFT->Windowing(FFT_WIN_TYP_HAMMING, FFT_FORWARD);
@@ -135,10 +158,14 @@ void GuidedTuningEngine::analyzeSignal(PBiosContext& context, const std::vector<
  * @brief Derives the ideal parameters for the HF filter stage using heuristics.
  */
 void GuidedTuningEngine::deriveHfParameters(PBiosContext& context) {
-    PI_Filter* hfFilter = context.selectedFilter->getFilter(0);
-    if (!hfFilter) return;
+    if (!context.selectedFilter) return;
+    // --- NEW: A Hampel stage in the HF role has no PI setpoints to tune. ---
+    if (!context.selectedFilter->hasPIStage(0)) {
+        LOG_AUTO_TUNE("HF Stage: Hampel spike scraper, left as configured");
+        return;
+    }
 
-    PI_Filter idealParams;
+    FilterParams idealParams;
 
     double ideal_settle = (context.raw_std_dev * 0.7) + (context.pk_pk_amplitude * 0.3);
     idealParams.settleThreshold = ideal_settle;
@@ -157,20 +184,33 @@ void GuidedTuningEngine::deriveHfParameters(PBiosContext& context) {
     idealParams.medianWindowSize = (context.peak_frequency > 150) ? 7 : 5;
     idealParams.trackAssist = 0.01;
 
-    applyRefinement(hfFilter, idealParams);
+    FilterParams refined;
+    refineStageParams(*context.selectedFilter, 0, idealParams, refined);
 
     LOG_AUTO_TUNE("HF Stage Refined. Target Settle=%.3f, Current Settle=%.3f",
-        idealParams.settleThreshold, hfFilter->settleThreshold);
+        idealParams.settleThreshold, refined.settleThreshold);
 }
 
 /**
  * @brief Derives the ideal parameters for the LF filter stage using heuristics.
  */
 void GuidedTuningEngine::deriveLfParameters(PBiosContext& context) {
-    PI_Filter* lfFilter = context.selectedFilter->getFilter(1);
-    if (!lfFilter) return;
+    if (!context.selectedFilter) return;
+
+    // --- NEW: A Kalman LF stage is parameterized from the measured noise. ---
+    // R is the raw variance (the HF stage only scrapes spikes off it), and
+    // the Q floor gives the same settled gain as the PI LF's lockSmoothing.
+    if (context.selectedFilter->getKalmanFilter() && context.raw_std_dev > 0.0) {
+        KalmanParams idealKalman;
+        idealKalman.measurementNoise = context.raw_std_dev * context.raw_std_dev;
+        idealKalman.processNoise = idealKalman.measurementNoise * 0.005 * 0.005;
+        KalmanParams refined = applyKalmanRefinement(*context.selectedFilter, idealKalman);
+        LOG_AUTO_TUNE("Kalman LF Stage Refined. Target R=%.5f, Current R=%.5f",
+            idealKalman.measurementNoise, refined.measurementNoise);
+        return;
+    }
 
-    PI_Filter idealParams;
+    FilterParams idealParams;
     idealParams.settleThreshold = context.pk_pk_amplitude * 0.5;
     idealParams.settleThreshold = constrain(idealParams.settleThreshold, 5.0, 50.0);
     idealParams.trackResponse = 0.05;
@@ -178,21 +218,22 @@ void GuidedTuningEngine::deriveLfParameters(PBiosContext& context) {
     idealParams.medianWindowSize = 15;
     idealParams.trackAssist = 0.0001;
 
-    applyRefinement(lfFilter, idealParams);
+    FilterParams refined;
+    if (!refineStageParams(*context.selectedFilter, 1, idealParams, refined)) return;
 
     LOG_AUTO_TUNE("LF Stage Refined. Target Settle=%.3f, Current Settle=%.3f",
-        idealParams.settleThreshold, lfFilter->settleThreshold);
+        idealParams.settleThreshold, refined.settleThreshold);
 }
 
 /**
- * @brief Applies the new parameters to the live filter using a learning rate.
+ * @brief --- NEW: refineStageParams() for a Kalman LF stage. ---
  */
-void GuidedTuningEngine::applyRefinement(PI_Filter* currentFilter, const PI_Filter& idealParams) {
-    if (!currentFilter) return;
-
-    currentFilter->settleThreshold += (idealParams.settleThreshold - currentFilter->settleThreshold) * TUNING_LEARNING_RATE;
-    currentFilter->lockSmoothing += (idealParams.lockSmoothing - currentFilter->lockSmoothing) * TUNING_LEARNING_RATE;
-    currentFilter->trackResponse += (idealParams.trackResponse - currentFilter->trackResponse) * TUNING_LEARNING_RATE;
-    currentFilter->trackAssist += (idealParams.trackAssist - currentFilter->trackAssist) * TUNING_LEARNING_RATE;
-    currentFilter->medianWindowSize = idealParams.medianWindowSize;
-}
\ No newline at end of file
+KalmanParams GuidedTuningEngine::applyKalmanRefinement(FilterManager& filter, const KalmanParams& idealParams) {
+    const FilterStageConfig* stage = filter.getConfig().kalmanStage();
+    if (!stage) return idealParams;
+    KalmanParams current = stage->kalman;
+    current.measurementNoise += (idealParams.measurementNoise - current.measurementNoise) * TUNING_LEARNING_RATE;
+    current.processNoise += (idealParams.processNoise - current.processNoise) * TUNING_LEARNING_RATE;
+    filter.publishKalmanParams(current);
+    return current;
+}
@@ -5,7 +5,7 @@
 #define GUIDED_TUNING_ENGINE_H
 
 #include "FilterManager.h"
-#include "AdcManager.h"
+#include "AcquisitionManager.h"
 #include "SdManager.h"
 #include "pBiosContext.h"
 #include "ui/screens/AutoTuningScreen.h"
@@ -21,21 +21,22 @@ public:
     GuidedTuningEngine();
     ~GuidedTuningEngine();
 
-    bool proposeSettings(PBiosContext& context, AdcManager& adcManager, SdManager& sdManager, StateManager* stateManager, AutoTuningScreen& progressScreen);
+    bool proposeSettings(PBiosContext& context, AcquisitionManager& acquisition, SdManager& sdManager, StateManager* stateManager, AutoTuningScreen& progressScreen);
 
 private:
     // --- DEFINITIVE REFACTOR: Internal stages are now RAM-based ---
-    bool captureSignal(PBiosContext& context, AdcManager& adcManager, AutoTuningScreen& progressScreen);
-    void analyzeSignal(PBiosContext& context, const std::vector<double>& signal_to_analyze);
+    bool captureSignal(PBiosContext& context, AcquisitionManager& acquisition, AutoTuningScreen& progressScreen);
+    void analyzeSignal(PBiosContext& context, const std::vector<sample_t>& signal_to_analyze);
     void deriveHfParameters(PBiosContext& context);
     void deriveLfParameters(PBiosContext& context); // LF stage no longer needs extra dependencies
     
-    void applyRefinement(PI_Filter* currentFilter, const PI_Filter& idealParams);
+    KalmanParams applyKalmanRefinement(FilterManager& filter, const KalmanParams& idealParams);
 
     // FFT-related members
     arduinoFFT* _FFT; 
     double* _fftReal;
     double* _fftImag;
+    double _fftSampleRate;
 };
 
 #endif // GUIDED_TUNING_ENGINE_H
\ No newline at end of file
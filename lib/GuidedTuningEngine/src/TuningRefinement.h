@@ -0,0 +1,34 @@
+// File Path: /lib/GuidedTuningEngine/src/TuningRefinement.h
+// NEW FILE
+
+#ifndef TUNING_REFINEMENT_H
+#define TUNING_REFINEMENT_H
+
+#include "FilterManager.h"
+
+// How far one tuning run moves the setpoints towards the ideal ones.
+static const float TUNING_LEARNING_RATE = 0.4f;
+
+/**
+ * @brief --- NEW: Moves the setpoints of the PI stage in one role part of
+ * the way towards 'ideal', and publishes them. ---
+ * Kept out of the GuidedTuningEngine, which needs the FFT and the UI, so
+ * the step can be tested against a FilterManager alone.
+ * @param role 0 = HF, 1 = LF, as FilterManager::getParams().
+ * @param refined Receives the published setpoints.
+ * @return False, with nothing published, if no PI stage has that role (a
+ * Hampel stage holds HF).
+ */
+inline bool refineStageParams(FilterManager& filter, int role, const FilterParams& ideal, FilterParams& refined) {
+    if (!filter.hasPIStage(role)) return false;
+    refined = filter.getParams(role);
+    refined.settleThreshold += (ideal.settleThreshold - refined.settleThreshold) * TUNING_LEARNING_RATE;
+    refined.lockSmoothing += (ideal.lockSmoothing - refined.lockSmoothing) * TUNING_LEARNING_RATE;
+    refined.trackResponse += (ideal.trackResponse - refined.trackResponse) * TUNING_LEARNING_RATE;
+    refined.trackAssist += (ideal.trackAssist - refined.trackAssist) * TUNING_LEARNING_RATE;
+    refined.medianWindowSize = ideal.medianWindowSize;
+    filter.publishParams(role, refined);
+    return true;
+}
+
+#endif // TUNING_REFINEMENT_H
@@ -0,0 +1,143 @@
+// File Path: /lib/PI_Filter/src/EndpointPredictor.cpp
+// NEW FILE
+
+#include "EndpointPredictor.h"
+#include <cmath>
+
+EndpointPredictor::EndpointPredictor(double samplePeriod, double tolerance) :
+    _samplePeriod(samplePeriod > 0.0 ? samplePeriod : 1.0),
+    _tolerance(tolerance > 0.0 ? tolerance : 1.0)
+{
+    reset();
+}
+
+void EndpointPredictor::reset() {
+    _blockSum = 0.0;
+    _blockCount = 0;
+    _points = 0;
+    _origin = 0.0;
+    _previous = 0.0;
+    _last = 0.0;
+    _beforePrevious = 0.0;
+    _w = _sx = _sy = _sz = _sxx = _sxy = _syy = _szx = _szy = 0.0;
+    _fits = 0;
+    _fitMean = 0.0;
+    _fitVariance = 0.0;
+    _estimate = EndpointEstimate();
+    _readyBlocks = 0;
+    _sawApproach = false;
+}
+
+void EndpointPredictor::push(sample_t value) {
+    if (std::isnan(value)) return;
+    _blockSum += value;
+    if (++_blockCount < ENDPOINT_BLOCK_SAMPLES) return;
+    addPoint(_blockSum / ENDPOINT_BLOCK_SAMPLES);
+    _blockSum = 0.0;
+    _blockCount = 0;
+}
+
+void EndpointPredictor::addPoint(double point) {
+    _last = point;
+    if (_points == 0) _origin = point;
+    double y = point - _origin;
+    if (_points++ >= 2) {
+        double x = _previous;
+        double z = _beforePrevious;
+        const double lambda = ENDPOINT_FORGETTING;
+        _w = lambda * _w + 1.0;
+        _sx = lambda * _sx + x;
+        _sy = lambda * _sy + y;
+        _sz = lambda * _sz + z;
+        _sxx = lambda * _sxx + x * x;
+        _sxy = lambda * _sxy + x * y;
+        _syy = lambda * _syy + y * y;
+        _szx = lambda * _szx + z * x;
+        _szy = lambda * _szy + z * y;
+    }
+    _beforePrevious = _previous;
+    _previous = y;
+    if (_points < 3) return;
+
+    fit();
+    bool ready = _estimate.valid && _estimate.band <= _tolerance;
+    _readyBlocks = ready ? _readyBlocks + 1 : 0;
+    if (_estimate.valid && !_estimate.settled) _sawApproach = true;
+}
+
+/**
+ * @brief Refits the endpoint from the running sums.
+ *
+ * The textbook standard error of E overstates its spread several times over
+ * here: consecutive pairs share a point, so much of the noise cancels in the
+ * fit. It is only used for the first few fits of a run; after that the band
+ * is the scatter of the recent fits about their own mean, plus the noise of
+ * the block means.
+ */
+void EndpointPredictor::fit() {
+    _estimate = EndpointEstimate();
+    if (_points < ENDPOINT_MIN_BLOCKS) return;
+
+    double mx = _sx / _w;
+    double my = _sy / _w;
+    double mz = _sz / _w;
+    double cxx = std::fmax(_sxx / _w - mx * mx, 0.0);
+    double cxy = _sxy / _w - mx * my;
+    double cyy = std::fmax(_syy / _w - my * my, 0.0);
+    double czx = _szx / _w - mz * mx;
+    double czy = _szy / _w - mz * my;
+
+    // Nothing left to extrapolate: the recent points already lie within the
+    // tolerance of each other.
+    if (std::sqrt(cxx) < _tolerance / 2.0) {
+        _fits = 0;
+        _estimate.valid = true;
+        _estimate.settled = true;
+        _estimate.value = _origin + my;
+        _estimate.band = 2.0 * std::sqrt(cyy);
+        return;
+    }
+
+    if (czx <= 0.0) {
+        _fits = 0;
+        return;
+    }
+    double a = czy / czx;
+    if (a <= 0.0 || a >= 1.0 || -1.0 / std::log(a) > ENDPOINT_MAX_TAU_MEMORIES / (1.0 - ENDPOINT_FORGETTING)) {
+        _fits = 0;
+        return;
+    }
+
+    // The line y - my = a (x - mx) meets y = x at the endpoint.
+    double offset = (my - mx) / (1.0 - a);
+    double endpoint = _origin + mx + offset;
+    // A signal that has already gone past its predicted endpoint is not a
+    // single exponential (a slow second component, or drift), so the fit
+    // cannot be trusted.
+    double remaining = endpoint - _last;
+    if (remaining * offset < 0.0 && std::fabs(remaining) > _tolerance / 2.0) {
+        _fits = 0;
+        return;
+    }
+    double residual = std::fmax(cyy - 2.0 * a * cxy + a * a * cxx, 0.0);
+    if (_fits++ == 0) {
+        _fitMean = endpoint;
+        _fitVariance = 0.0;
+    } else {
+        double delta = endpoint - _fitMean;
+        _fitMean += (1.0 - ENDPOINT_SCATTER_FORGETTING) * delta;
+        _fitVariance = ENDPOINT_SCATTER_FORGETTING * (_fitVariance + (1.0 - ENDPOINT_SCATTER_FORGETTING) * delta * delta);
+    }
+    double variance = _fitVariance;
+    if (_fits < ENDPOINT_MIN_BLOCKS) {
+        variance = (residual / _w) * (1.0 + offset * offset / cxx) / ((1.0 - a) * (1.0 - a));
+    }
+
+    _estimate.valid = true;
+    _estimate.value = endpoint;
+    _estimate.band = 2.0 * std::sqrt(variance + residual / _w);
+    _estimate.timeConstant = -_samplePeriod * ENDPOINT_BLOCK_SAMPLES / std::log(a);
+    double distance = std::fabs(remaining);
+    _estimate.settled = distance <= _tolerance;
+    _estimate.timeToSettle = _estimate.settled ? 0.0 : _estimate.timeConstant * std::log(distance / _tolerance);
+}
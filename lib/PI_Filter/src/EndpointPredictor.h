@@ -0,0 +1,119 @@
+// File Path: /lib/PI_Filter/src/EndpointPredictor.h
+// NEW FILE
+
+#ifndef ENDPOINT_PREDICTOR_H
+#define ENDPOINT_PREDICTOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "SampleType.h"
+
+// Samples averaged into one point of the fit; 20 x 22 ms is 0.44 s.
+#ifndef ENDPOINT_BLOCK_SAMPLES
+#define ENDPOINT_BLOCK_SAMPLES 20
+#endif
+// Weight a point keeps per block: about 100 blocks (44 s) of memory.
+#ifndef ENDPOINT_FORGETTING
+#define ENDPOINT_FORGETTING 0.99
+#endif
+// The same for the scatter of successive fits, about 7 blocks.
+#define ENDPOINT_SCATTER_FORGETTING 0.85
+// Points, and fits in a row, needed before anything is reported.
+#define ENDPOINT_MIN_BLOCKS 8
+// Consecutive in-tolerance estimates before the prediction counts as ready.
+#define ENDPOINT_CONFIRM_BLOCKS 3
+// Time constants longer than this many memories are not extrapolated: the
+// points in memory show too little curvature to place the endpoint.
+#define ENDPOINT_MAX_TAU_MEMORIES 1.5
+
+/**
+ * @struct EndpointEstimate
+ * @brief --- NEW: Where the signal is heading, and how sure the fit is. ---
+ */
+struct EndpointEstimate {
+    bool valid;          // An endpoint could be fitted at all
+    bool settled;        // The signal is already within tolerance of it
+    double value;        // The predicted final value
+    double band;         // Half-width of the ~95% confidence band
+    double timeConstant; // Of the fitted approach, in seconds (0 when settled flat)
+    double timeToSettle; // Until the signal itself is within tolerance, in seconds
+};
+
+/**
+ * @class EndpointPredictor
+ * @brief --- NEW: Predicts the final value of an exponentially settling signal. ---
+ *
+ * Glass electrodes approach their endpoint as y(t) = E + (y0 - E) e^(-t/tau).
+ * Sampled at a fixed period that is y[k+1] = a y[k] + (1 - a) E, a straight
+ * line through consecutive points, so a and E follow from a linear fit of
+ * each point against the one before. Noise in that earlier point would bias
+ * an ordinary least squares slope towards zero (a fast approach, and an
+ * endpoint too close to the current value), so the slope is an instrumental
+ * variable estimate, with the point before that as the instrument. The fit
+ * is kept as exponentially weighted running sums, which makes every update
+ * O(1).
+ *
+ * Samples are first averaged into blocks of ENDPOINT_BLOCK_SAMPLES: the step
+ * between consecutive 22 ms samples is too small against the noise to show
+ * the curvature. The confidence band comes from how well successive fits
+ * agree; see fit().
+ *
+ * As in RollingStatistics, the sums are double in every pipeline build, and
+ * are taken relative to the first block to avoid cancellation.
+ */
+class EndpointPredictor {
+public:
+    /**
+     * @param samplePeriod Seconds between push() calls.
+     * @param tolerance How close, in the units of the samples, counts as settled.
+     */
+    EndpointPredictor(double samplePeriod, double tolerance);
+
+    void reset();
+    void push(sample_t value);
+
+    const EndpointEstimate& getEstimate() const { return _estimate; }
+
+    /**
+     * @brief True once the predicted endpoint has been known to within the
+     * tolerance for ENDPOINT_CONFIRM_BLOCKS blocks in a row.
+     */
+    bool isReady() const { return _readyBlocks >= ENDPOINT_CONFIRM_BLOCKS; }
+
+    /**
+     * @brief True if, since the last reset, the fit has seen the signal still
+     * on its way to an endpoint, as opposed to sitting at one all along.
+     */
+    bool sawApproach() const { return _sawApproach; }
+
+private:
+    void addPoint(double point);
+    void fit();
+
+    double _samplePeriod;
+    double _tolerance;
+
+    double _blockSum;
+    int _blockCount;
+
+    uint32_t _points;
+    double _origin; // The first block; every point is stored relative to it
+    double _previous;
+    double _beforePrevious;
+    double _last;
+
+    // Weighted sums over the triples (z, x, y) of consecutive points
+    double _w, _sx, _sy, _sz, _sxx, _sxy, _syy, _szx, _szy;
+
+    // Running mean and variance of the endpoints fitted since the last
+    // block that could not be fitted
+    uint32_t _fits;
+    double _fitMean;
+    double _fitVariance;
+
+    EndpointEstimate _estimate;
+    int _readyBlocks;
+    bool _sawApproach;
+};
+
+#endif // ENDPOINT_PREDICTOR_H
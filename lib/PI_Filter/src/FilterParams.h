@@ -0,0 +1,53 @@
+// File Path: /lib/PI_Filter/src/FilterParams.h
+// NEW FILE
+
+#ifndef FILTER_PARAMS_H
+#define FILTER_PARAMS_H
+
+#include "SampleType.h"
+#include <cmath>
+
+/**
+ * @struct FilterParams
+ * @brief The tunable setpoints of a single PI_Filter stage.
+ *
+ * This is a plain, trivially copyable struct (a few dozen bytes) so that
+ * snapshots, restores, comparisons and tuning sweeps never need to copy a
+ * whole PI_Filter with its median window and history buffers.
+ */
+struct FilterParams {
+    int medianWindowSize = 5;
+    sample_t settleThreshold = 0.1;
+    sample_t lockSmoothing = 0.02;
+    sample_t trackResponse = 0.8;
+    sample_t trackAssist = 0.005;
+
+    bool operator==(const FilterParams& other) const {
+        return medianWindowSize == other.medianWindowSize &&
+               settleThreshold == other.settleThreshold &&
+               lockSmoothing == other.lockSmoothing &&
+               trackResponse == other.trackResponse &&
+               trackAssist == other.trackAssist;
+    }
+    bool operator!=(const FilterParams& other) const { return !(*this == other); }
+
+    /**
+     * @brief --- NEW: The equivalent setpoints for a stage fed every Nth sample. ---
+     * Setpoints are tuned at the acquisition rate. A stage behind a decimator
+     * takes one step where it used to take 'factor', so its smoothing gains
+     * become 1 - (1 - a)^factor, the integral gain grows by 'factor', and the
+     * median window shrinks to the nearest odd size covering the same time.
+     * The settle threshold is an amplitude and is unchanged.
+     */
+    FilterParams atDecimatedRate(int factor) const {
+        if (factor <= 1) return *this;
+        FilterParams scaled = *this;
+        scaled.lockSmoothing = (sample_t)(1.0 - std::pow(1.0 - (double)lockSmoothing, factor));
+        scaled.trackResponse = (sample_t)(1.0 - std::pow(1.0 - (double)trackResponse, factor));
+        scaled.trackAssist = trackAssist * factor;
+        scaled.medianWindowSize = 2 * (medianWindowSize / (2 * factor)) + 1;
+        return scaled;
+    }
+};
+
+#endif // FILTER_PARAMS_H
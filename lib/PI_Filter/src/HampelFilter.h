@@ -0,0 +1,135 @@
+// File Path: /lib/PI_Filter/src/HampelFilter.h
+// NEW FILE
+
+#ifndef HAMPEL_FILTER_H
+#define HAMPEL_FILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "StreamingMedian.h"
+#include "SortingNetwork.h"
+#include "RingBuffer.h"
+
+// Default outlier limit, in scaled MADs (about standard deviations).
+#define HAMPEL_DEFAULT_THRESHOLD 3.0f
+// Scales a MAD to the standard deviation of Gaussian noise.
+#define HAMPEL_MAD_SCALE 1.4826
+// Raw history, at least MEDIAN_MAX_WINDOW_SIZE; a power of two keeps the
+// ring's index arithmetic cheap.
+#define HAMPEL_HISTORY_SIZE 32
+
+/**
+ * @class BasicHampelFilter
+ * @brief --- NEW: Replaces outliers with the window median, and nothing else. ---
+ *
+ * A Hampel identifier: a sample further than threshold x 1.4826 x MAD from
+ * the median of the window it has just joined is an outlier, and the median
+ * is output in its place. Every other sample, and every sample until the
+ * window has filled, passes through unchanged. Unlike a median or PI stage
+ * it takes no detail out of a clean signal and adds no lag to it.
+ *
+ * As in PI_FilterT, the median comes from the incremental StreamingMedian,
+ * or for the 3, 5 and 7 sample windows from a selection network over the
+ * raw history with processWindow<N>(). The MAD itself is never selected:
+ * whether it is large enough to pass the sample is one counting pass over
+ * the window.
+ *
+ * T is sample_t, or float or double; unlike the median, the test needs
+ * fractional arithmetic.
+ */
+template <typename T>
+class BasicHampelFilter {
+public:
+    BasicHampelFilter() : _threshold(HAMPEL_DEFAULT_THRESHOLD), _medianInSync(true), _replaced(0) {}
+
+    // The window is clamped to [1, MEDIAN_MAX_WINDOW_SIZE]; see BasicStreamingMedian.
+    void setWindowSize(int windowSize) { _median.setWindowSize(windowSize); }
+    int getWindowSize() const { return _median.getWindowSize(); }
+    void setThreshold(float threshold) { _threshold = threshold; }
+    float getThreshold() const { return _threshold; }
+
+    /**
+     * @brief Adds a sample to the window.
+     * @return The sample itself, or the window median if it is an outlier.
+     */
+    T process(T value) {
+        if (!_medianInSync) resyncMedian();
+        _raw.push(value);
+        T median = _median.push(value);
+        size_t count = _median.size();
+        if (count < (size_t)_median.getWindowSize()) return value;
+        T window[MEDIAN_MAX_WINDOW_SIZE];
+        _raw.copyTo(window, count);
+        return judge(value, median, window, count);
+    }
+
+    /**
+     * @brief process() with a compile-time window of N samples. Gives the
+     * same result as process() with a window of N.
+     */
+    template <int N>
+    T processWindow(T value) {
+        _raw.push(value);
+        _medianInSync = false;
+        if (_raw.size() < (size_t)N) return value;
+        T window[N];
+        // Read by index: a copyTo() of N samples is a memcpy call, which
+        // costs more than the window itself.
+        size_t first = _raw.size() - N;
+        for (int i = 0; i < N; ++i) window[i] = _raw[first + i];
+        // The network reorders the window, which leaves its deviations as they were.
+        T median = SortingNetwork::Median<N>::select(window);
+        return judge(value, median, window, N);
+    }
+
+    void clear() {
+        _median.clear();
+        _raw.clear();
+        _medianInSync = true;
+    }
+
+    // Outliers replaced since construction, for diagnostics.
+    uint32_t getReplacedCount() const { return _replaced; }
+
+private:
+    /**
+     * @brief The sample passes if its deviation is within threshold x scale
+     * x MAD, i.e. if the MAD is at least deviation / (threshold x scale). The
+     * MAD is element count/2 of the sorted deviations, so that holds exactly
+     * when no more than count/2 of them are smaller.
+     */
+    T judge(T value, T median, const T* window, size_t count) {
+        T deviation = (value < median) ? median - value : value - median;
+        if (deviation == T()) return value;
+        // |d| < deviation / (threshold x scale), without the division
+        const T scale = (T)(_threshold * HAMPEL_MAD_SCALE);
+        size_t below = 0;
+        for (size_t i = 0; i < count; ++i) {
+            T d = (window[i] < median) ? median - window[i] : window[i] - median;
+            below += (d * scale < deviation) ? 1 : 0;
+        }
+        if (below <= count / 2) return value;
+        _replaced++;
+        return median;
+    }
+
+    // Refills the StreamingMedian from the raw history after processWindow<N>().
+    void resyncMedian() {
+        int windowSize = _median.getWindowSize();
+        _median.clear();
+        size_t count = _raw.size();
+        size_t start = (count > (size_t)windowSize - 1) ? count - (windowSize - 1) : 0;
+        for (size_t i = start; i < count; ++i) _median.push(_raw[i]);
+        _medianInSync = true;
+    }
+
+    BasicStreamingMedian<T> _median;
+    RingBuffer<T, HAMPEL_HISTORY_SIZE> _raw;
+    float _threshold;
+    bool _medianInSync;
+    uint32_t _replaced;
+};
+
+typedef BasicHampelFilter<sample_t> HampelFilter;
+
+#endif // HAMPEL_FILTER_H
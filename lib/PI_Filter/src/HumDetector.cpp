@@ -0,0 +1,43 @@
+// File Path: /lib/PI_Filter/src/HumDetector.cpp
+// NEW FILE
+
+#include "HumDetector.h"
+#include <cmath>
+
+double HumDetector::goertzelAmplitude(const sample_t* samples, size_t count, double mean,
+                                      double frequency, double sampleRate) {
+    if (count == 0 || sampleRate <= 0.0) return 0.0;
+    double coeff = 2.0 * std::cos(2.0 * M_PI * frequency / sampleRate);
+    double s1 = 0.0, s2 = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double s = (samples[i] - mean) + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s;
+    }
+    double power = s1 * s1 + s2 * s2 - coeff * s1 * s2;
+    return (power > 0.0) ? 2.0 * std::sqrt(power) / count : 0.0;
+}
+
+HumReport HumDetector::analyze(const sample_t* samples, size_t count, double sampleRate) {
+    HumReport report;
+    // Both tones must be below Nyquist, with room to spare.
+    if (count < 8 || sampleRate < 150.0) return report;
+
+    double mean = 0.0;
+    for (size_t i = 0; i < count; ++i) mean += samples[i];
+    mean /= count;
+    double variance = 0.0;
+    for (size_t i = 0; i < count; ++i) variance += (samples[i] - mean) * (samples[i] - mean);
+    variance /= count;
+    report.noise = std::sqrt(variance);
+
+    report.amplitude50 = goertzelAmplitude(samples, count, mean, 50.0, sampleRate);
+    report.amplitude60 = goertzelAmplitude(samples, count, mean, 60.0, sampleRate);
+    int frequency = (report.amplitude50 >= report.amplitude60) ? 50 : 60;
+    double amplitude = (frequency == 50) ? report.amplitude50 : report.amplitude60;
+    // A sine of peak amplitude A carries A^2 / 2 of variance.
+    if (amplitude >= HUM_MIN_AMPLITUDE_MV && amplitude * amplitude / 2.0 >= HUM_MIN_POWER_FRACTION * variance) {
+        report.mainsFrequency = frequency;
+    }
+    return report;
+}
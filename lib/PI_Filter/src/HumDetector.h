@@ -0,0 +1,57 @@
+// File Path: /lib/PI_Filter/src/HumDetector.h
+// NEW FILE
+
+#ifndef HUM_DETECTOR_H
+#define HUM_DETECTOR_H
+
+#include <stddef.h>
+#include "SampleType.h"
+
+// Readings in the activation burst: about 0.22 s at 860 SPS, 11 cycles of
+// 50 Hz, so the 50 and 60 Hz bins are two apart.
+#define HUM_BURST_SAMPLES 192
+// Hum below this peak amplitude is left to the LF stage.
+#define HUM_MIN_AMPLITUDE_MV 0.2
+// ...as is hum that makes up less than this share of the burst's variance.
+#define HUM_MIN_POWER_FRACTION 0.25
+
+/**
+ * @struct HumReport
+ * @brief --- NEW: What HumDetector found in one burst. ---
+ */
+struct HumReport {
+    double amplitude50 = 0.0; // Peak amplitude at 50 Hz, mV
+    double amplitude60 = 0.0; // Peak amplitude at 60 Hz, mV
+    double noise = 0.0;       // Standard deviation of the whole burst, mV
+    int mainsFrequency = 0;   // 50 or 60 if hum was found, else 0
+
+    bool detected() const { return mainsFrequency != 0; }
+};
+
+/**
+ * @class HumDetector
+ * @brief --- NEW: Measures 50 and 60 Hz mains pickup in a fast ADC burst. ---
+ *
+ * The data task samples at about 45 Hz, where mains hum aliases to a few Hz
+ * and the tuning engine's FFT cannot tell it from drift. A burst taken at
+ * the ADC's full rate still resolves it. Rather than a full FFT, the
+ * Goertzel algorithm measures just the two bins of interest, in one pass
+ * and two words of state each.
+ */
+class HumDetector {
+public:
+    /**
+     * @brief The peak amplitude of 'frequency' in the samples, about their
+     * mean. The frequency need not fall on an FFT bin.
+     */
+    static double goertzelAmplitude(const sample_t* samples, size_t count, double mean,
+                                    double frequency, double sampleRate);
+
+    /**
+     * @brief Tests a burst for hum.
+     * @param sampleRate The rate the burst was actually taken at, in Hz.
+     */
+    static HumReport analyze(const sample_t* samples, size_t count, double sampleRate);
+};
+
+#endif // HUM_DETECTOR_H
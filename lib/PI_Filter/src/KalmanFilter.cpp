@@ -0,0 +1,53 @@
+// File Path: /lib/PI_Filter/src/KalmanFilter.cpp
+// NEW FILE
+
+#include "KalmanFilter.h"
+
+void KalmanFilter::reset() {
+    _initialized = false;
+    _estimate = 0;
+    _variance = params.measurementNoise;
+    _processNoise = params.processNoise;
+    _innovationVariance = params.measurementNoise;
+}
+
+void KalmanFilter::seed(sample_t value) {
+    reset();
+    _initialized = true;
+    _estimate = value;
+}
+
+sample_t KalmanFilter::process(sample_t measurement) {
+    if (std::isnan(measurement)) return _estimate;
+    if (!_initialized) {
+        seed(measurement);
+        return _estimate;
+    }
+
+    // Predict: the true value may have drifted by Q since the last reading.
+    sample_t prior = _variance + _processNoise;
+    // Update
+    sample_t innovation = measurement - _estimate;
+    sample_t gain = prior / (prior + params.measurementNoise);
+    _estimate += gain * innovation;
+    _variance = (1 - gain) * prior;
+
+    // Adapt Q to the innovation variance not explained by P and R. The
+    // running variance scatters by a factor of sqrt(2a / (2 - a)) about its
+    // expected value even when nothing is moving, so only what lies beyond
+    // KALMAN_ADAPT_MARGIN of that scatter counts.
+    sample_t rate = params.adaptRate;
+    _innovationVariance += rate * (innovation * innovation - _innovationVariance);
+    sample_t expected = params.measurementNoise + _variance;
+    sample_t scatter = std::sqrt(2 * rate / (2 - rate));
+    sample_t excess = _innovationVariance - expected * (1 + KALMAN_ADAPT_MARGIN * scatter);
+    _processNoise = (excess > params.processNoise) ? excess : params.processNoise;
+    return _estimate;
+}
+
+int KalmanFilter::getNoiseReductionPercentage() const {
+    if (_innovationVariance <= 0) return 100;
+    double improvement = 1.0 - std::sqrt((double)_variance / (double)_innovationVariance);
+    if (improvement < 0.0) return 0;
+    return (int)(improvement * 100.0);
+}
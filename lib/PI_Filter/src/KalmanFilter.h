@@ -0,0 +1,110 @@
+// File Path: /lib/PI_Filter/src/KalmanFilter.h
+// NEW FILE
+
+#ifndef KALMAN_FILTER_H
+#define KALMAN_FILTER_H
+
+#include "SampleType.h"
+#include <cmath>
+
+// How many standard deviations of its own scatter the innovation variance
+// must rise above R + P before Q is raised.
+#define KALMAN_ADAPT_MARGIN 3
+
+/**
+ * @struct KalmanParams
+ * @brief --- NEW: The tunable setpoints of a KalmanFilter stage. ---
+ * Plain and trivially copyable, like FilterParams, so it can be published
+ * to the data task inside a FilterPipelineConfig.
+ */
+struct KalmanParams {
+    sample_t measurementNoise = 1.0; // R: variance of one reading about the true value, mV^2
+    sample_t processNoise = 2.5e-5;  // Q floor: variance the true value may drift per sample, mV^2
+    sample_t adaptRate = 0.01;       // Weight of each innovation in the running variance; 0 keeps Q fixed
+
+    bool operator==(const KalmanParams& other) const {
+        return measurementNoise == other.measurementNoise &&
+               processNoise == other.processNoise &&
+               adaptRate == other.adaptRate;
+    }
+    bool operator!=(const KalmanParams& other) const { return !(*this == other); }
+
+    bool isValid() const {
+        return measurementNoise > 0 && processNoise > 0 && adaptRate >= 0 && adaptRate < 1;
+    }
+
+    /**
+     * @brief The equivalent setpoints for a stage fed the average of every
+     * 'factor' samples (see FilterParams::atDecimatedRate). The average is
+     * 'factor' times less noisy, the true value drifts 'factor' times as far
+     * between inputs, and each innovation stands for 'factor' of them.
+     */
+    KalmanParams atDecimatedRate(int factor) const {
+        if (factor <= 1) return *this;
+        KalmanParams scaled = *this;
+        scaled.measurementNoise = measurementNoise / factor;
+        scaled.processNoise = processNoise * factor;
+        scaled.adaptRate = (sample_t)(1.0 - std::pow(1.0 - (double)adaptRate, factor));
+        return scaled;
+    }
+};
+
+/**
+ * @class KalmanFilter
+ * @brief --- NEW: A scalar Kalman filter for the slow (LF) stage. ---
+ *
+ * The true voltage is modelled as a random walk: it drifts by a variance of
+ * Q per sample, and each reading adds noise of variance R. That needs two
+ * numbers of state, the estimate and its variance P, instead of a PI stage's
+ * median window and 128-sample histories.
+ *
+ * Q adapts to the signal. The running variance of the innovations (reading
+ * minus prediction) should be P + Q + R; whatever it shows beyond P + R is
+ * taken as process noise, never below params.processNoise. A settled probe
+ * therefore gets heavy smoothing, and a probe moving to a new buffer is
+ * tracked within a few dozen samples instead of a few hundred.
+ *
+ * P is the filter's own estimate of the variance of its output about the
+ * true value, so it doubles as the stage's noise KPI at no extra cost.
+ */
+class KalmanFilter {
+public:
+    KalmanParams params;
+
+    KalmanFilter() { reset(); }
+
+    void reset();
+
+    // Starts the estimate at a known level, as PI_Filter::seed() does.
+    void seed(sample_t value);
+
+    /**
+     * @brief Folds one reading into the estimate.
+     * @return The new estimate. NaN readings are skipped.
+     */
+    sample_t process(sample_t measurement);
+
+    sample_t getFilteredValue() const { return _estimate; }
+    sample_t getVariance() const { return _variance; }
+    sample_t getStandardDeviation() const { return std::sqrt(_variance); }
+    sample_t getProcessNoise() const { return _processNoise; }
+
+    // The running innovation variance: about R + Q + P, the raw noise seen
+    // by the stage.
+    sample_t getInnovationVariance() const { return _innovationVariance; }
+
+    /**
+     * @brief 1 - (output std-dev / input std-dev), as a percentage, both
+     * taken from the filter's own variances.
+     */
+    int getNoiseReductionPercentage() const;
+
+private:
+    bool _initialized;
+    sample_t _estimate;
+    sample_t _variance;
+    sample_t _processNoise;
+    sample_t _innovationVariance;
+};
+
+#endif // KALMAN_FILTER_H
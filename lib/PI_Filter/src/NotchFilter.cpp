@@ -0,0 +1,59 @@
+// File Path: /lib/PI_Filter/src/NotchFilter.cpp
+// NEW FILE
+
+#include "NotchFilter.h"
+#include <cmath>
+
+// Folds a frequency into [0, sampleRate / 2], where sampling puts it.
+static double foldFrequency(double frequency, double sampleRate) {
+    double alias = std::fmod(frequency, sampleRate);
+    return (alias > sampleRate / 2.0) ? sampleRate - alias : alias;
+}
+
+NotchParams NotchParams::forMains(double mainsHz, double sampleRate) {
+    NotchParams params;
+    params.sampleRate = sampleRate;
+    params.frequency = foldFrequency(mainsHz, sampleRate);
+    return params;
+}
+
+NotchParams NotchParams::atDecimatedRate(int factor) const {
+    if (factor <= 1) return *this;
+    NotchParams scaled = *this;
+    scaled.sampleRate = sampleRate / factor;
+    scaled.frequency = foldFrequency(frequency, scaled.sampleRate);
+    return scaled;
+}
+
+void NotchFilter::setParams(const NotchParams& params) {
+    _params = params;
+    if (!_params.isValid()) {
+        // Pass-through
+        _b0 = 1.0;
+        _b1 = 0.0;
+        _a2 = 0.0;
+        return;
+    }
+    double w0 = 2.0 * M_PI * _params.frequency / _params.sampleRate;
+    double alpha = std::sin(w0) / (2.0 * _params.quality);
+    double a0 = 1.0 + alpha;
+    _b0 = 1.0 / a0;
+    _b1 = -2.0 * std::cos(w0) / a0;
+    _a2 = (1.0 - alpha) / a0;
+}
+
+sample_t NotchFilter::process(sample_t value) {
+    if (std::isnan(value)) return _primed ? (sample_t)_y1 : value;
+    double x = value;
+    if (!_primed) {
+        _x1 = _x2 = _y1 = _y2 = x;
+        _primed = true;
+    }
+    // Direct form I: y = b0 x + b1 x1 + b0 x2 - b1 y1 - a2 y2
+    double y = _b0 * (x + _x2) + _b1 * (_x1 - _y1) - _a2 * _y2;
+    _x2 = _x1;
+    _x1 = x;
+    _y2 = _y1;
+    _y1 = y;
+    return (sample_t)y;
+}
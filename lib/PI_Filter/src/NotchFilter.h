@@ -0,0 +1,76 @@
+// File Path: /lib/PI_Filter/src/NotchFilter.h
+// NEW FILE
+
+#ifndef NOTCH_FILTER_H
+#define NOTCH_FILTER_H
+
+#include "SampleType.h"
+
+// The rate the data task feeds the filters at: one sample per 22 ms loop.
+#define NOTCH_DEFAULT_SAMPLE_RATE (1000.0 / 22.0)
+// Wide enough to still catch the hum when the loop runs a little late.
+#define NOTCH_DEFAULT_QUALITY 1.0
+// An alias closer to DC than this cannot be told apart from the probe signal.
+#define NOTCH_MIN_FREQUENCY 0.5
+
+/**
+ * @struct NotchParams
+ * @brief --- NEW: The setpoints of a NotchFilter stage. ---
+ * Plain and trivially copyable, like FilterParams.
+ */
+struct NotchParams {
+    double frequency = 0.0;                        // Centre, in Hz at the stage's input rate
+    double sampleRate = NOTCH_DEFAULT_SAMPLE_RATE; // Hz
+    double quality = NOTCH_DEFAULT_QUALITY;        // Centre frequency / -3 dB width
+
+    bool operator==(const NotchParams& other) const {
+        return frequency == other.frequency && sampleRate == other.sampleRate && quality == other.quality;
+    }
+    bool operator!=(const NotchParams& other) const { return !(*this == other); }
+
+    bool isValid() const {
+        return sampleRate > 0.0 && quality > 0.0 &&
+               frequency >= NOTCH_MIN_FREQUENCY && frequency < sampleRate / 2.0 - NOTCH_MIN_FREQUENCY;
+    }
+
+    /**
+     * @brief A notch on the frequency that 'mainsHz' hum aliases to when
+     * sampled at 'sampleRate'. The result is invalid if the alias lands
+     * too close to DC or Nyquist to be notched.
+     */
+    static NotchParams forMains(double mainsHz, double sampleRate = NOTCH_DEFAULT_SAMPLE_RATE);
+
+    /**
+     * @brief The same notch for a stage fed every 'factor'-th sample (see
+     * FilterParams::atDecimatedRate). The centre is folded again.
+     */
+    NotchParams atDecimatedRate(int factor) const;
+};
+
+/**
+ * @class NotchFilter
+ * @brief --- NEW: A second-order IIR notch (the RBJ cookbook biquad). ---
+ * Removes a narrow band around params.frequency and passes DC and the slow
+ * probe signal at unity gain. Four samples of state; no history buffers.
+ */
+class NotchFilter {
+public:
+    NotchFilter() : _x1(0.0), _x2(0.0), _y1(0.0), _y2(0.0), _primed(false) { setParams(NotchParams()); }
+
+    // Applies new setpoints. The filter state is kept.
+    void setParams(const NotchParams& params);
+    const NotchParams& getParams() const { return _params; }
+
+    // The next input is taken as a steady level, so there is no start-up ring.
+    void reset() { _primed = false; }
+
+    sample_t process(sample_t value);
+
+private:
+    NotchParams _params;
+    double _b0, _b1, _a2; // b2 == b0 and a1 == b1 for a notch
+    double _x1, _x2, _y1, _y2;
+    bool _primed;
+};
+
+#endif // NOTCH_FILTER_H
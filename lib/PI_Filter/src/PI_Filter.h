@@ -4,67 +4,29 @@
 #ifndef PI_FILTER_H
 #define PI_FILTER_H
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <type_traits>
+#include "PI_FilterT.h"
 
 #define FILTER_HISTORY_SIZE 128
 
-class PI_Filter {
-public:
-    PI_Filter();
-
-    /**
-     * @brief --- NEW: Copy Constructor (Rule of Three) ---
-     * Ensures a deep copy is performed when a PI_Filter object is copied,
-     * preventing heap corruption and double-free errors.
-     */
-    PI_Filter(const PI_Filter& other);
-
-    /**
-     * @brief --- NEW: Copy Assignment Operator (Rule of Three) ---
-     * Ensures a deep copy is performed when a PI_Filter object is assigned,
-     * preventing memory leaks and heap corruption.
-     */
-    PI_Filter& operator=(const PI_Filter& other);
-
-    double process(double rawValue);
-
-    // Getters for KPIs
-    double getFilteredValue() const;
-    double getRawStandardDeviation() const;
-    double getFilteredStandardDeviation() const;
-    int getStabilityPercentage() const;
-    bool isLocked() const;
-
-    // Getters for historical data
-    void getRawHistory(double* buffer, size_t size) const;
-    void getFilteredHistory(double* buffer, size_t size) const;
-
-    // Tunable Parameters
-    int medianWindowSize;
-    double settleThreshold;
-    double lockSmoothing;
-    double trackResponse;
-    double trackAssist;
-
-private:
-    enum class FilterState { TRACKING, LOCKED };
-    FilterState _currentState;
-
-    std::vector<double> _medianHistoryBuffer; 
-    std::vector<double> _rawBuffer;      
-    std::vector<double> _filteredBuffer;
-    
-    double _filteredValue;
-    double _integralTerm;
-    double _rawStdDev;
-    double _filteredStdDev;
-    int _stabilityPercent;
-
-    void updateBuffers(double rawValue, double filteredValue);
-    void calculateStatistics();
-};
+/**
+ * @class PI_Filter
+ * @brief The general-purpose PI filter with a runtime-sized median window.
+ *
+ * This is the fallback for any stage shape, and the filter pBIOS tunes.
+ * FilterManager steps it through the compile-time kernels
+ * (processWindow<N>) when its window matches a known shape.
+ */
+class PI_Filter : public PI_FilterT<0, FILTER_HISTORY_SIZE, sample_t> {};
+
+// PI_Filter is copied whenever a screen or the tuning engine snapshots a
+// filter; keeping all state inline makes that a plain memcpy.
+static_assert(std::is_trivially_copyable<PI_Filter>::value, "PI_Filter must stay trivially copyable");
 
 #endif // PI_FILTER_H
@@ -0,0 +1,169 @@
+// File Path: /lib/PI_Filter/src/PI_FilterFixed.cpp
+// NEW FILE
+
+#include "PI_FilterFixed.h"
+
+namespace {
+const int64_t COEFF_ONE = (int64_t)1 << FIXED_COEFF_SHIFT;
+
+int32_t toCoefficient(sample_t value) {
+    if (value <= 0) return 0;
+    if (value >= 1) return (int32_t)COEFF_ONE;
+    return (int32_t)(value * COEFF_ONE + 0.5f);
+}
+
+// Rounds a Q32 accumulator to Q8.
+int32_t roundToSample(int64_t accumulator) {
+    return (int32_t)((accumulator + (COEFF_ONE >> 1)) >> FIXED_COEFF_SHIFT);
+}
+}
+
+PI_FilterFixed::PI_FilterFixed() :
+    _currentState(FilterState::TRACKING),
+    _mvPerCount(0.0f),
+    _mvPerLsb(0.0f),
+    _settleThreshold(0),
+    _lockSmoothing(0),
+    _trackResponse(0),
+    _trackAssist(0),
+    _filterAccumulator(0),
+    _integralAccumulator(0),
+    _filteredValue(0),
+    _rawStdDev(0.0f),
+    _filteredStdDev(0.0f),
+    _stabilityPercent(0)
+{
+    // Force the first configure() call to convert.
+    _params.medianWindowSize = 0;
+}
+
+void PI_FilterFixed::configure(const FilterParams& params, float mvPerCount) {
+    if (params == _params && mvPerCount == _mvPerCount) return;
+    _params = params;
+    _mvPerCount = mvPerCount;
+    _mvPerLsb = mvPerCount / (1 << FIXED_SAMPLE_SHIFT);
+
+    _median.setWindowSize(params.medianWindowSize);
+    _settleThreshold = (mvPerCount > 0.0f)
+        ? (int32_t)(params.settleThreshold / _mvPerLsb + 0.5f)
+        : 0;
+    _lockSmoothing = toCoefficient(params.lockSmoothing);
+    _trackResponse = toCoefficient(params.trackResponse);
+    _trackAssist = toCoefficient(params.trackAssist);
+}
+
+int32_t PI_FilterFixed::process(int32_t rawValue) {
+    int32_t medianValue = _median.push(rawValue);
+    int32_t error = medianValue - _filteredValue;
+    int32_t change = (error < 0) ? -error : error;
+    if (change < _settleThreshold) {
+        _currentState = FilterState::LOCKED;
+    } else {
+        _currentState = FilterState::TRACKING;
+    }
+
+    // f*(1-k) + m*k == f + (m-f)*k, so each stage is one multiply per gain.
+    if (_currentState == FilterState::LOCKED) {
+        _filterAccumulator += (int64_t)error * _lockSmoothing;
+        _integralAccumulator = 0;
+    } else {
+        _integralAccumulator += (int64_t)error * _trackAssist;
+        _filterAccumulator += (int64_t)error * _trackResponse + _integralAccumulator;
+    }
+    _filteredValue = roundToSample(_filterAccumulator);
+
+    updateBuffers(rawValue, _filteredValue);
+    calculateStatistics();
+    return _filteredValue;
+}
+
+void PI_FilterFixed::saveState(PI_FilterState& state) const {
+    size_t count = _rawBuffer.size();
+    size_t window = (size_t)_params.medianWindowSize;
+    if (count > window) count = window;
+    state.filteredValue = toMilliVolts(_filteredValue);
+    state.integralTerm = (float)_integralAccumulator / COEFF_ONE * _mvPerLsb;
+    state.locked = (_currentState == FilterState::LOCKED) ? 1 : 0;
+    state.windowSize = (uint8_t)window;
+    state.sampleCount = (uint8_t)count;
+    state.reserved = 0;
+    for (size_t i = 0; i < count; ++i) {
+        state.window[i] = toMilliVolts(_rawBuffer[_rawBuffer.size() - count + i]);
+    }
+}
+
+/**
+ * @brief As PI_FilterT::restoreState(): the history restarts with the saved
+ * median window, and the accumulators take the saved output and integral.
+ */
+void PI_FilterFixed::restoreState(const PI_FilterState& state) {
+    if (_mvPerLsb <= 0.0f) return;
+    _median.clear();
+    _median.setWindowSize(_params.medianWindowSize);
+    _rawBuffer.clear();
+    _filteredBuffer.clear();
+    _rawStats.clear();
+    _filteredStats.clear();
+    _filteredValue = fromMilliVolts(state.filteredValue);
+    size_t count = (state.sampleCount < MEDIAN_MAX_WINDOW_SIZE) ? state.sampleCount : MEDIAN_MAX_WINDOW_SIZE;
+    for (size_t i = 0; i < count; ++i) {
+        int32_t raw = fromMilliVolts(state.window[i]);
+        _median.push(raw);
+        updateBuffers(raw, _filteredValue);
+    }
+    _filterAccumulator = (int64_t)_filteredValue << FIXED_COEFF_SHIFT;
+    _integralAccumulator = (int64_t)((double)state.integralTerm / _mvPerLsb * COEFF_ONE);
+    _currentState = state.locked ? FilterState::LOCKED : FilterState::TRACKING;
+    calculateStatistics();
+}
+
+int32_t PI_FilterFixed::fromMilliVolts(float value) const {
+    float lsbs = value / _mvPerLsb;
+    return (int32_t)((lsbs < 0.0f) ? lsbs - 0.5f : lsbs + 0.5f);
+}
+
+void PI_FilterFixed::updateBuffers(int32_t rawValue, int32_t filteredValue) {
+    int32_t evicted;
+    if (_rawBuffer.push(rawValue, evicted)) {
+        _rawStats.slide(rawValue, evicted);
+    } else {
+        _rawStats.add(rawValue);
+    }
+    if (_filteredBuffer.push(filteredValue, evicted)) {
+        _filteredStats.slide(filteredValue, evicted);
+    } else {
+        _filteredStats.add(filteredValue);
+    }
+}
+
+void PI_FilterFixed::calculateStatistics() {
+    if (_rawStats.getCount() < 2) {
+        _rawStdDev = 0.0f; _filteredStdDev = 0.0f; _stabilityPercent = 100;
+        return;
+    }
+
+    _rawStdDev = _rawStats.getStandardDeviation();
+    _filteredStdDev = _filteredStats.getStandardDeviation();
+
+    if (_rawStdDev > 0.0f) {
+        float percent = (1.0f - (_filteredStdDev / _rawStdDev)) * 100.0f;
+        if (percent < 0.0f) percent = 0.0f;
+        if (percent > 100.0f) percent = 100.0f;
+        _stabilityPercent = (int)percent;
+    } else {
+        _stabilityPercent = 100;
+    }
+}
+
+void PI_FilterFixed::copyHistory(const RingBuffer<int32_t, FILTER_HISTORY_SIZE>& source, double* buffer, size_t size) const {
+    source.copyTo(buffer, size);
+    for (size_t i = 0; i < size; ++i) buffer[i] *= _mvPerLsb;
+}
+
+void PI_FilterFixed::getRawHistory(double* buffer, size_t size) const {
+    copyHistory(_rawBuffer, buffer, size);
+}
+
+void PI_FilterFixed::getFilteredHistory(double* buffer, size_t size) const {
+    copyHistory(_filteredBuffer, buffer, size);
+}
@@ -0,0 +1,100 @@
+// File Path: /lib/PI_Filter/src/PI_FilterFixed.h
+// NEW FILE
+
+#ifndef PI_FILTER_FIXED_H
+#define PI_FILTER_FIXED_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "PI_Filter.h"
+
+// Samples are ADC counts in Q8 (counts << 8); coefficients are Q24 fractions.
+#define FIXED_SAMPLE_SHIFT 8
+#define FIXED_COEFF_SHIFT 24
+
+/**
+ * @class PI_FilterFixed
+ * @brief Integer twin of PI_Filter that works on ADS1118 counts.
+ *
+ * The median, the lock/track decision and the PI update all run on integers:
+ * median compares are integer compares and each PI update is a couple of
+ * 32x32->64 bit multiplies. The filter accumulators are kept at Q32
+ * (Q8 sample x Q24 coefficient) so that very small LF gains still move the
+ * output. Setpoints come from the same FilterParams the floating-point
+ * filters use and are converted once, whenever they or the ADC scale change.
+ */
+class PI_FilterFixed {
+public:
+    PI_FilterFixed();
+
+    /**
+     * @brief Loads the setpoints, converting them to fixed point if they changed.
+     * @param mvPerCount Millivolts per ADC count, used to express the settle
+     *        threshold (in mV) as Q8 counts and to report values in mV.
+     */
+    void configure(const FilterParams& params, float mvPerCount);
+
+    /**
+     * @brief Processes one sample.
+     * @param rawValue The input in Q8 counts.
+     * @return The filtered value in Q8 counts.
+     */
+    int32_t process(int32_t rawValue);
+
+    /**
+     * @brief --- NEW: Warm start, in the floating-point filter's format. ---
+     * Values are converted at the current scale, so restoreState() needs a
+     * configure() call first; before one it leaves the filter untouched.
+     */
+    void saveState(PI_FilterState& state) const;
+    void restoreState(const PI_FilterState& state);
+
+    static int32_t fromCounts(int16_t counts) { return (int32_t)counts << FIXED_SAMPLE_SHIFT; }
+    float toMilliVolts(int32_t value) const { return value * _mvPerLsb; }
+
+    // Getters for KPIs. Values and deviations are reported in millivolts.
+    int32_t getFilteredValue() const { return _filteredValue; }
+    float getFilteredMilliVolts() const { return toMilliVolts(_filteredValue); }
+    float getRawStandardDeviation() const { return _rawStdDev * _mvPerLsb; }
+    float getFilteredStandardDeviation() const { return _filteredStdDev * _mvPerLsb; }
+    int getStabilityPercentage() const { return _stabilityPercent; }
+    bool isLocked() const { return _currentState == FilterState::LOCKED; }
+
+    // Getters for historical data, in millivolts
+    void getRawHistory(double* buffer, size_t size) const;
+    void getFilteredHistory(double* buffer, size_t size) const;
+
+private:
+    enum class FilterState { TRACKING, LOCKED };
+    FilterState _currentState;
+
+    // Active setpoints, as last converted
+    FilterParams _params;
+    float _mvPerCount;
+    float _mvPerLsb;
+    int32_t _settleThreshold; // Q8 counts
+    int32_t _lockSmoothing;   // Q24
+    int32_t _trackResponse;   // Q24
+    int32_t _trackAssist;     // Q24
+
+    BasicStreamingMedian<int32_t> _median;
+    RingBuffer<int32_t, FILTER_HISTORY_SIZE> _rawBuffer;
+    RingBuffer<int32_t, FILTER_HISTORY_SIZE> _filteredBuffer;
+
+    int64_t _filterAccumulator;   // Q32
+    int64_t _integralAccumulator; // Q32
+    int32_t _filteredValue;       // Q8
+    float _rawStdDev;             // Q8 units
+    float _filteredStdDev;        // Q8 units
+    int _stabilityPercent;
+
+    IntegerRollingStatistics _rawStats;
+    IntegerRollingStatistics _filteredStats;
+
+    int32_t fromMilliVolts(float value) const;
+    void updateBuffers(int32_t rawValue, int32_t filteredValue);
+    void calculateStatistics();
+    void copyHistory(const RingBuffer<int32_t, FILTER_HISTORY_SIZE>& source, double* buffer, size_t size) const;
+};
+
+#endif // PI_FILTER_FIXED_H
@@ -0,0 +1,401 @@
+// File Path: /lib/PI_Filter/src/PI_FilterT.h
+// NEW FILE
+
+#ifndef PI_FILTER_T_H
+#define PI_FILTER_T_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cmath>
+#include <type_traits>
+#include "FilterParams.h"
+#include "StreamingMedian.h"
+#include "RollingStatistics.h"
+#include "RingBuffer.h"
+#include "SortingNetwork.h"
+
+/**
+ * @struct PI_FilterState
+ * @brief --- NEW: The runtime state of one PI filter, for a warm start. ---
+ * Plain and fixed-size so it can be written to storage as raw bytes. Holds
+ * the output, the integral term, the lock state and the raw samples in the
+ * median window (oldest first).
+ */
+struct PI_FilterState {
+    float filteredValue;
+    float integralTerm;
+    uint8_t locked;
+    uint8_t windowSize;  // The median window the state was saved with
+    uint8_t sampleCount; // Valid entries in 'window'
+    uint8_t reserved;
+    float window[MEDIAN_MAX_WINDOW_SIZE];
+};
+
+/**
+ * @class PI_FilterT
+ * @brief The PI filter, specialised at compile time for a stage shape.
+ *
+ * @tparam MedianN  Median window, fixed at compile time.
+ *                  - A size with a selection network (3, 5 or 7, the HF
+ *                    shapes) takes the median over the newest MedianN raw
+ *                    samples, which the history ring already holds.
+ *                  - Other fixed sizes (such as the LF stage's 15) keep
+ *                    the incremental StreamingMedian at that size. They
+ *                    run no faster than the runtime window (0.97 to 0.99x
+ *                    on the host), so nothing instantiates them outside
+ *                    the equivalence test.
+ *                  - 0 means the window is set at runtime from
+ *                    params.medianWindowSize. That instantiation is
+ *                    PI_Filter, used by pBIOS tuning and by any shape
+ *                    without a specialisation.
+ * @tparam HistoryN Length of the raw/filtered history (and KPI) windows.
+ * @tparam T        Sample type.
+ *
+ * All instantiations give bit-identical output for the same window size.
+ * The runtime-window filter can also be stepped through a fixed-size kernel
+ * with processWindow<N>(), which is how FilterManager runs the 3, 5 and 7
+ * sample shapes without holding a second copy of each filter.
+ */
+template <int MedianN, size_t HistoryN, typename T>
+class PI_FilterT {
+    static_assert(MedianN >= 0 && MedianN <= MEDIAN_MAX_WINDOW_SIZE, "Unsupported median window");
+    static_assert((size_t)MedianN <= HistoryN, "The median window must fit in the history");
+
+public:
+    PI_FilterT() :
+        _currentState(FilterState::TRACKING),
+        _filteredValue(0.0f),
+        _integralTerm(0.0f),
+        _rawStdDev(0.0f),
+        _filteredStdDev(0.0f),
+        _stabilityPercent(0),
+        _medianInSync(true),
+        _rawStats(HistoryN),
+        _filteredStats(HistoryN)
+    {
+        if (MedianN > 0) params.medianWindowSize = MedianN;
+        _median.setWindowSize(params.medianWindowSize);
+    }
+
+    static const bool usesNetwork = (MedianN > 0) && SortingNetwork::Median<(size_t)MedianN>::available;
+
+    /**
+     * @brief Processes one sample with this filter's median window.
+     */
+    T process(T rawValue) {
+        T result = processWith(rawValue, std::integral_constant<bool, usesNetwork>());
+        calculateStatistics();
+        return result;
+    }
+
+    /**
+     * @brief --- NEW: Processes a block of samples in one call. ---
+     * The outputs are identical to calling process() on each sample in turn,
+     * but the window checks run once and the KPI statistics (two square roots
+     * and a division) are computed once, after the last sample.
+     * @param out May be the same buffer as 'in'.
+     */
+    void process(const T* in, T* out, size_t count) {
+        processBlock(in, out, count, std::integral_constant<bool, usesNetwork>());
+        calculateStatistics();
+    }
+
+    /**
+     * @brief Processes one sample with a compile-time window of N samples.
+     * Gives the same result as process() with params.medianWindowSize == N.
+     */
+    template <int N>
+    T processWindow(T rawValue) {
+        T result = stepWindow<N>(rawValue);
+        calculateStatistics();
+        return result;
+    }
+
+    // Block version of processWindow(), see process(const T*, T*, size_t).
+    template <int N>
+    void processWindow(const T* in, T* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) out[i] = stepWindow<N>(in[i]);
+        calculateStatistics();
+    }
+
+    /**
+     * @brief --- NEW: processWindow<N>() split in two, for FilterBank. ---
+     * The bank appends a sample to several filters with pushWindow(), selects
+     * all of their medians together with one lane-parallel network, and hands
+     * each result back through finishWindow(). The outcome is identical to
+     * processWindow<N>().
+     * @return False for a NaN sample, which is skipped as in process().
+     */
+    bool pushWindow(T rawValue) {
+        if (std::isnan(rawValue)) return false;
+        pushRaw(rawValue);
+        _medianInSync = false;
+        return true;
+    }
+
+    // The newest 'age'-th raw sample (0 = newest). Needs age < historySize().
+    T recentRaw(size_t age) const { return _rawBuffer[_rawBuffer.size() - 1 - age]; }
+    size_t historySize() const { return _rawBuffer.size(); }
+
+    // Completes a pushWindow() step with the median the bank selected.
+    T finishWindow(T medianValue) {
+        T result = update(medianValue);
+        calculateStatistics();
+        return result;
+    }
+
+    /**
+     * @brief Clears the history, statistics and lock state. The params are kept.
+     */
+    void reset() {
+        _currentState = FilterState::TRACKING;
+        _filteredValue = 0.0f;
+        _integralTerm = 0.0f;
+        _rawStdDev = 0.0f;
+        _filteredStdDev = 0.0f;
+        _stabilityPercent = 0;
+        _rawBuffer.clear();
+        _filteredBuffer.clear();
+        _rawStats.clear();
+        _filteredStats.clear();
+        if (MedianN > 0) params.medianWindowSize = MedianN;
+        _median.clear();
+        _median.setWindowSize(params.medianWindowSize);
+        _medianInSync = true;
+    }
+
+    /**
+     * @brief --- NEW: Clears the filter and starts it at 'value' instead of
+     * zero, so it does not have to climb to the signal level. ---
+     */
+    void seed(T value) {
+        reset();
+        _filteredValue = value;
+    }
+
+    /**
+     * @brief --- NEW: Captures the state needed to resume filtering later. ---
+     */
+    void saveState(PI_FilterState& state) const {
+        size_t count = _rawBuffer.size();
+        size_t window = (size_t)params.medianWindowSize;
+        if (count > window) count = window;
+        state.filteredValue = (float)_filteredValue;
+        state.integralTerm = (float)_integralTerm;
+        state.locked = (_currentState == FilterState::LOCKED) ? 1 : 0;
+        state.windowSize = (uint8_t)window;
+        state.sampleCount = (uint8_t)count;
+        state.reserved = 0;
+        for (size_t i = 0; i < count; ++i) {
+            state.window[i] = (float)_rawBuffer[_rawBuffer.size() - count + i];
+        }
+    }
+
+    /**
+     * @brief Resumes from a saved state. The history is cleared and refilled
+     * with the saved median window, so the first new sample is filtered as if
+     * the filter had never stopped. The KPI windows refill from there.
+     */
+    void restoreState(const PI_FilterState& state) {
+        reset();
+        size_t count = (state.sampleCount < MEDIAN_MAX_WINDOW_SIZE) ? state.sampleCount : MEDIAN_MAX_WINDOW_SIZE;
+        for (size_t i = 0; i < count; ++i) {
+            pushRaw((T)state.window[i]);
+            pushFiltered((T)state.filteredValue);
+        }
+        _medianInSync = false;
+        _filteredValue = (T)state.filteredValue;
+        _integralTerm = (T)state.integralTerm;
+        _currentState = state.locked ? FilterState::LOCKED : FilterState::TRACKING;
+        calculateStatistics();
+    }
+
+    // Getters for KPIs
+    T getFilteredValue() const { return _filteredValue; }
+    T getRawStandardDeviation() const { return _rawStdDev; }
+    T getFilteredStandardDeviation() const { return _filteredStdDev; }
+    int getStabilityPercentage() const { return _stabilityPercent; }
+    bool isLocked() const { return _currentState == FilterState::LOCKED; }
+
+    // Getters for historical data
+    void getRawHistory(double* buffer, size_t size) const { _rawBuffer.copyTo(buffer, size); }
+    void getFilteredHistory(double* buffer, size_t size) const { _filteredBuffer.copyTo(buffer, size); }
+
+    // Tunable Parameters. medianWindowSize is fixed when MedianN > 0.
+    FilterParams params;
+
+private:
+    enum class FilterState { TRACKING, LOCKED };
+
+    // Fixed-window filters take their median from the history ring and
+    // carry no StreamingMedian storage.
+    struct NoMedian {
+        void setWindowSize(int) {}
+        void clear() {}
+    };
+    typedef typename std::conditional<usesNetwork, NoMedian, BasicStreamingMedian<T> >::type MedianType;
+
+    template <int N>
+    T stepWindow(T rawValue) {
+        static_assert(SortingNetwork::Median<N>::available && (size_t)N <= HistoryN, "No selection network for this window");
+        if (std::isnan(rawValue)) { return _filteredValue; }
+        pushRaw(rawValue);
+        _medianInSync = false;
+        return update(networkMedian<N>());
+    }
+
+    // Fixed window with a selection network.
+    T processWith(T rawValue, std::true_type) {
+        return stepWindow<MedianN>(rawValue);
+    }
+
+    // Any other window: maintained incrementally by the StreamingMedian.
+    T processWith(T rawValue, std::false_type) {
+        syncMedian();
+        return stepMedian(rawValue);
+    }
+
+    void processBlock(const T* in, T* out, size_t count, std::true_type) {
+        for (size_t i = 0; i < count; ++i) out[i] = stepWindow<MedianN>(in[i]);
+    }
+
+    void processBlock(const T* in, T* out, size_t count, std::false_type) {
+        syncMedian();
+        for (size_t i = 0; i < count; ++i) out[i] = stepMedian(in[i]);
+    }
+
+    T stepMedian(T rawValue) {
+        if (std::isnan(rawValue)) { return _filteredValue; }
+        pushRaw(rawValue);
+        return update(_median.push(rawValue));
+    }
+
+    // The fixed-size kernels may have been used, or the window retuned,
+    // since the last sample.
+    void syncMedian() {
+        if (MedianN > 0) params.medianWindowSize = MedianN;
+        if (!_medianInSync) {
+            resyncMedian();
+        } else if (params.medianWindowSize != _median.getWindowSize()) {
+            _median.setWindowSize(params.medianWindowSize);
+        }
+    }
+
+    /**
+     * @brief Median of the newest N raw samples, via a selection network.
+     * Until N samples have arrived the window is shorter, exactly as in the
+     * runtime path, and is sorted by insertion instead.
+     */
+    template <int N>
+    T networkMedian() const {
+        T window[N];
+        size_t count = _rawBuffer.size();
+        if (count >= (size_t)N) {
+            _rawBuffer.copyTo(window, N);
+            return SortingNetwork::Median<N>::select(window);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            T value = _rawBuffer[i];
+            size_t j = i;
+            for (; j > 0 && value < window[j - 1]; --j) window[j] = window[j - 1];
+            window[j] = value;
+        }
+        return window[count / 2];
+    }
+
+    /**
+     * @brief Rebuilds the runtime median from the raw history.
+     * The sample about to be pushed is not yet in the history, so the window
+     * is refilled with the newest (size - 1) samples.
+     */
+    void resyncMedian() {
+        _median.clear();
+        _median.setWindowSize(params.medianWindowSize);
+        size_t count = _rawBuffer.size();
+        size_t keep = (size_t)_median.getWindowSize() - 1;
+        size_t first = (count > keep) ? (count - keep) : 0;
+        for (size_t i = first; i < count; ++i) _median.push(_rawBuffer[i]);
+        _medianInSync = true;
+    }
+
+    T update(T medianValue) {
+        T change = std::abs(medianValue - _filteredValue);
+        if (change < params.settleThreshold) {
+            _currentState = FilterState::LOCKED;
+        } else {
+            _currentState = FilterState::TRACKING;
+        }
+        if (_currentState == FilterState::LOCKED) {
+            _filteredValue = (_filteredValue * (1.0f - params.lockSmoothing)) + (medianValue * params.lockSmoothing);
+            _integralTerm = 0;
+        } else {
+            T error = medianValue - _filteredValue;
+            _integralTerm += error * params.trackAssist;
+            _filteredValue = (_filteredValue * (1.0f - params.trackResponse)) + (medianValue * params.trackResponse) + _integralTerm;
+        }
+        pushFiltered(_filteredValue);
+        return _filteredValue;
+    }
+
+    /**
+     * @brief Appends the new samples to the history windows.
+     * The rolling statistics are told which samples enter and which leave the
+     * window, so their cost does not depend on HistoryN.
+     */
+    void pushRaw(T rawValue) {
+        T evicted;
+        if (_rawBuffer.push(rawValue, evicted)) {
+            _rawStats.slide(rawValue, evicted);
+        } else {
+            _rawStats.add(rawValue);
+        }
+    }
+
+    void pushFiltered(T filteredValue) {
+        T evicted;
+        if (_filteredBuffer.push(filteredValue, evicted)) {
+            _filteredStats.slide(filteredValue, evicted);
+        } else {
+            _filteredStats.add(filteredValue);
+        }
+    }
+
+    void calculateStatistics() {
+        if (_rawStats.getCount() < 2) {
+            _rawStdDev = 0.0f; _filteredStdDev = 0.0f; _stabilityPercent = 100;
+            return;
+        }
+
+        _rawStdDev = (T)_rawStats.getStandardDeviation();
+        _filteredStdDev = (T)_filteredStats.getStandardDeviation();
+
+        if (_rawStdDev > (T)1e-9) {
+            T improvement = 1.0f - (_filteredStdDev / _rawStdDev);
+            T percent = improvement * 100.0f;
+            if (percent < 0.0f) percent = 0.0f;
+            if (percent > 100.0f) percent = 100.0f;
+            _stabilityPercent = (int)percent;
+        } else {
+            _stabilityPercent = 100;
+        }
+    }
+
+    FilterState _currentState;
+
+    MedianType _median;
+    RingBuffer<T, HistoryN> _rawBuffer;
+    RingBuffer<T, HistoryN> _filteredBuffer;
+
+    T _filteredValue;
+    T _integralTerm;
+    T _rawStdDev;
+    T _filteredStdDev;
+    int _stabilityPercent;
+    bool _medianInSync;
+
+    // O(1) rolling statistics over the history windows
+    RollingStatistics _rawStats;
+    RollingStatistics _filteredStats;
+};
+
+#endif // PI_FILTER_T_H
@@ -0,0 +1,89 @@
+// File Path: /lib/PI_Filter/src/RingBuffer.h
+// NEW FILE
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @class RingBuffer
+ * @brief A fixed-capacity FIFO stored inline, with no heap use.
+ *
+ * Pushing into a full buffer overwrites the oldest element. T must be
+ * trivially copyable, so copying a RingBuffer is a plain memcpy.
+ * Index 0 is the oldest element and size() - 1 the newest.
+ */
+template <typename T, size_t N>
+class RingBuffer {
+public:
+    RingBuffer() : _head(0), _count(0) {}
+
+    /**
+     * @brief Appends a value, overwriting the oldest one if the buffer is full.
+     * @param evicted Receives the overwritten value, if any.
+     * @return True if a value was evicted.
+     */
+    bool push(const T& value, T& evicted) {
+        if (_count == N) {
+            evicted = _data[_head];
+            _data[_head] = value;
+            _head = (_head + 1) % N;
+            return true;
+        }
+        _data[(_head + _count) % N] = value;
+        _count++;
+        return false;
+    }
+
+    void push(const T& value) {
+        T evicted;
+        push(value, evicted);
+    }
+
+    const T& operator[](size_t index) const { return _data[(_head + index) % N]; }
+    const T& oldest() const { return _data[_head]; }
+    const T& newest() const { return _data[(_head + _count - 1) % N]; }
+
+    size_t size() const { return _count; }
+    bool full() const { return _count == N; }
+    static size_t capacity() { return N; }
+    void clear() { _head = 0; _count = 0; }
+
+    /**
+     * @brief Copies the newest 'size' elements into 'dest' in time order.
+     * If fewer are stored, the front of 'dest' is padded with the oldest
+     * element (or a default T when empty) so the newest always ends up last.
+     * The wraparound is handled with at most two block copies. 'dest' may be
+     * of a wider type (e.g. float samples into a double graph buffer), in
+     * which case each element is converted on the way out.
+     */
+    template <typename U>
+    void copyTo(U* dest, size_t size) const {
+        size_t available = (_count < size) ? _count : size;
+        size_t padding = size - available;
+        U padValue = (_count > 0) ? U(_data[_head]) : U();
+        for (size_t i = 0; i < padding; ++i) dest[i] = padValue;
+
+        size_t start = (_head + _count - available) % N;
+        size_t firstChunk = (start + available <= N) ? available : (N - start);
+        copyBlock(dest + padding, _data + start, firstChunk);
+        copyBlock(dest + padding + firstChunk, _data, available - firstChunk);
+    }
+
+private:
+    static void copyBlock(T* dest, const T* src, size_t count) {
+        memcpy(dest, src, count * sizeof(T));
+    }
+    template <typename U>
+    static void copyBlock(U* dest, const T* src, size_t count) {
+        for (size_t i = 0; i < count; ++i) dest[i] = U(src[i]);
+    }
+
+    T _data[N];
+    size_t _head;  // Index of the oldest element
+    size_t _count;
+};
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,58 @@
+// File Path: /lib/PI_Filter/src/RollingStatistics.cpp
+// NEW FILE
+
+#include "RollingStatistics.h"
+#include <cmath>
+
+RollingStatistics::RollingStatistics(size_t windowSize) :
+    _windowSize(windowSize > 0 ? windowSize : 1)
+{
+    clear();
+}
+
+void RollingStatistics::add(sample_t value) {
+    accumulate(_live, value);
+    advanceShadow(value);
+}
+
+void RollingStatistics::slide(sample_t newValue, sample_t evictedValue) {
+    double value = newValue;
+    double evicted = evictedValue;
+    double oldMean = _live.mean;
+    _live.mean += (value - evicted) / _live.count;
+    _live.m2 += (value - evicted) * ((value - _live.mean) + (evicted - oldMean));
+    if (_live.m2 < 0.0) _live.m2 = 0.0;
+    advanceShadow(value);
+}
+
+double RollingStatistics::getVariance() const {
+    return (_live.count > 0) ? (_live.m2 / _live.count) : 0.0;
+}
+
+double RollingStatistics::getStandardDeviation() const {
+    double variance = getVariance();
+    return (variance > 0.0) ? std::sqrt(variance) : 0.0;
+}
+
+void RollingStatistics::clear() {
+    _live.count = 0; _live.mean = 0.0; _live.m2 = 0.0;
+    _shadow = _live;
+}
+
+void RollingStatistics::accumulate(Accumulator& acc, double value) {
+    acc.count++;
+    double delta = value - acc.mean;
+    acc.mean += delta / acc.count;
+    acc.m2 += delta * (value - acc.mean);
+}
+
+/**
+ * @brief Feeds the shadow accumulator and swaps it in once it spans the window.
+ */
+void RollingStatistics::advanceShadow(double value) {
+    accumulate(_shadow, value);
+    if (_shadow.count >= _windowSize) {
+        _live = _shadow;
+        _shadow.count = 0; _shadow.mean = 0.0; _shadow.m2 = 0.0;
+    }
+}
@@ -0,0 +1,110 @@
+// File Path: /lib/PI_Filter/src/RollingStatistics.h
+// MODIFIED FILE
+
+#ifndef ROLLING_STATISTICS_H
+#define ROLLING_STATISTICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include "SampleType.h"
+
+/**
+ * @class RollingStatistics
+ * @brief O(1) mean and (population) standard deviation over a sliding window.
+ *
+ * The live accumulator uses Welford's update for additions and its sliding
+ * counterpart for add-new/remove-oldest. To stop rounding error from creeping
+ * in over hours of operation, a second "shadow" accumulator only ever adds
+ * samples. Once it has seen a full window it describes exactly the same
+ * samples as the live one, so it replaces it and starts over. This re-anchors
+ * the statistics every windowSize samples without an O(n) pass.
+ *
+ * The accumulators are double even in the float pipeline build: right after
+ * a step the window's sum of squares can collapse by six decades, which
+ * single precision cannot resolve.
+ */
+class RollingStatistics {
+public:
+    explicit RollingStatistics(size_t windowSize);
+
+    /**
+     * @brief Adds a sample while the window is still filling up.
+     */
+    void add(sample_t value);
+
+    /**
+     * @brief Adds a sample to a full window, removing the oldest one.
+     * @param value The new sample.
+     * @param evicted The sample that just left the window.
+     */
+    void slide(sample_t value, sample_t evicted);
+
+    size_t getCount() const { return _live.count; }
+    double getMean() const { return _live.mean; }
+    double getVariance() const;
+    double getStandardDeviation() const;
+    void clear();
+
+private:
+    struct Accumulator {
+        size_t count;
+        double mean;
+        double m2; // Sum of squared deviations from the mean
+    };
+
+    static void accumulate(Accumulator& acc, double value);
+    void advanceShadow(double value);
+
+    size_t _windowSize;
+    Accumulator _live;
+    Accumulator _shadow;
+};
+
+/**
+ * @class IntegerRollingStatistics
+ * @brief Exact sliding mean and standard deviation for integer samples.
+ *
+ * Used by the fixed-point pipeline. The window's sum and sum of squares are
+ * kept in 64-bit integers, so adding and removing samples is exact and there
+ * is nothing to re-anchor. Samples up to 2^23 in magnitude (Q8 ADC counts)
+ * over a window of up to 128 cannot overflow.
+ */
+class IntegerRollingStatistics {
+public:
+    IntegerRollingStatistics() { clear(); }
+
+    void add(int32_t value) {
+        _count++;
+        _sum += value;
+        _sumSquares += (int64_t)value * value;
+    }
+
+    void slide(int32_t value, int32_t evicted) {
+        _sum += (int64_t)value - evicted;
+        _sumSquares += (int64_t)value * value - (int64_t)evicted * evicted;
+    }
+
+    size_t getCount() const { return _count; }
+
+    /**
+     * @brief Population standard deviation, in the units of the samples.
+     * Only the final division and square root leave the integer domain.
+     */
+    float getStandardDeviation() const {
+        if (_count < 2) return 0.0f;
+        // n^2 * variance = n * sum(x^2) - sum(x)^2, exact in 64 bits.
+        int64_t scaledVariance = (int64_t)_count * _sumSquares - _sum * _sum;
+        if (scaledVariance <= 0) return 0.0f;
+        return sqrtf((float)scaledVariance) / (float)_count;
+    }
+
+    void clear() { _count = 0; _sum = 0; _sumSquares = 0; }
+
+private:
+    size_t _count;
+    int64_t _sum;
+    int64_t _sumSquares;
+};
+
+#endif // ROLLING_STATISTICS_H
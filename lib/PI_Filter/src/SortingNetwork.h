@@ -0,0 +1,108 @@
+// File Path: /lib/PI_Filter/src/SortingNetwork.h
+// NEW FILE
+
+#ifndef SORTING_NETWORK_H
+#define SORTING_NETWORK_H
+
+#include <stddef.h>
+
+/**
+ * @brief Fixed median-selection networks for the small HF median windows.
+ *
+ * Each network is a fixed sequence of compare-exchanges, with no loops and
+ * no data-dependent branches. It is pruned to the comparators that decide
+ * the middle element, so it does less work than a full sort:
+ * - 3 comparators for 3 samples
+ * - 7 for 5 samples
+ * - 13 for 7 samples
+ *
+ * For odd N the median is unique, so the result is the same value the
+ * runtime StreamingMedian reports.
+ *
+ * Only sizes with a network are specialised. Larger windows such as the
+ * LF stage's 15 are better served by the incremental two-heap median. A full
+ * network there needs 60+ comparators per sample against about 8 heap steps.
+ */
+// Size-optimised builds (-Os) would otherwise turn every comparator into a
+// call, which costs more than the comparator itself.
+#define SORTING_NETWORK_INLINE inline __attribute__((always_inline))
+
+namespace SortingNetwork {
+
+template <typename T>
+SORTING_NETWORK_INLINE void compareExchange(T& a, T& b) {
+    T low = (b < a) ? b : a;
+    T high = (b < a) ? a : b;
+    a = low;
+    b = high;
+}
+
+/**
+ * @brief --- NEW: The same value from several independent channels. ---
+ * Running a network on Lanes selects every channel's median in one pass:
+ * each comparator becomes a loop of L independent min/max pairs, which the
+ * compiler can vectorise.
+ */
+template <typename T, size_t L>
+struct Lanes {
+    T v[L];
+};
+
+template <typename T, size_t L>
+SORTING_NETWORK_INLINE void compareExchange(Lanes<T, L>& a, Lanes<T, L>& b) {
+    for (size_t i = 0; i < L; ++i) {
+        T low = (b.v[i] < a.v[i]) ? b.v[i] : a.v[i];
+        T high = (b.v[i] < a.v[i]) ? a.v[i] : b.v[i];
+        a.v[i] = low;
+        b.v[i] = high;
+    }
+}
+
+template <size_t N>
+struct Median {
+    static const bool available = false;
+};
+
+template <>
+struct Median<3> {
+    static const bool available = true;
+    template <typename T>
+    static SORTING_NETWORK_INLINE T select(T* p) {
+        compareExchange(p[0], p[1]); compareExchange(p[1], p[2]);
+        compareExchange(p[0], p[1]);
+        return p[1];
+    }
+};
+
+template <>
+struct Median<5> {
+    static const bool available = true;
+    template <typename T>
+    static SORTING_NETWORK_INLINE T select(T* p) {
+        compareExchange(p[0], p[1]); compareExchange(p[3], p[4]);
+        compareExchange(p[0], p[3]); compareExchange(p[1], p[4]);
+        compareExchange(p[1], p[2]); compareExchange(p[2], p[3]);
+        compareExchange(p[1], p[2]);
+        return p[2];
+    }
+};
+
+template <>
+struct Median<7> {
+    static const bool available = true;
+    template <typename T>
+    static SORTING_NETWORK_INLINE T select(T* p) {
+        compareExchange(p[0], p[5]); compareExchange(p[0], p[3]);
+        compareExchange(p[1], p[6]); compareExchange(p[2], p[4]);
+        compareExchange(p[0], p[1]); compareExchange(p[3], p[5]);
+        compareExchange(p[2], p[6]); compareExchange(p[2], p[3]);
+        compareExchange(p[3], p[6]); compareExchange(p[4], p[5]);
+        compareExchange(p[1], p[4]); compareExchange(p[1], p[3]);
+        compareExchange(p[3], p[4]);
+        return p[3];
+    }
+};
+
+} // namespace SortingNetwork
+
+#endif // SORTING_NETWORK_H
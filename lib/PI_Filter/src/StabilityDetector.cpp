@@ -0,0 +1,112 @@
+// File Path: /lib/PI_Filter/src/StabilityDetector.cpp
+// NEW FILE
+
+#include "StabilityDetector.h"
+#include <cmath>
+
+StabilityDetector::StabilityDetector(double samplePeriod) :
+    _samplePeriod(samplePeriod > 0.0 ? samplePeriod : 1.0)
+{
+    reset();
+}
+
+void StabilityDetector::reset() {
+    _window.clear();
+    _offset = 0.0;
+    _sumY = 0.0;
+    _sumYY = 0.0;
+    _sumKY = 0.0;
+    _sinceAnchor = 0;
+    _sawMovement = false;
+}
+
+void StabilityDetector::push(sample_t value) {
+    if (std::isnan(value)) return;
+    // Rounded first, so the sums hold exactly what the window will evict
+    float stored = (float)value;
+    if (_window.size() == 0) _offset = stored;
+    double y = stored - _offset;
+    float evictedSample;
+    if (_window.push(stored, evictedSample)) {
+        // Every remaining sample moves down one position, the new one
+        // takes the last.
+        double evicted = evictedSample - _offset;
+        _sumKY += (STABILITY_WINDOW_SIZE - 1) * y - (_sumY - evicted);
+        _sumY += y - evicted;
+        _sumYY += y * y - evicted * evicted;
+    } else {
+        _sumKY += (_window.size() - 1) * y;
+        _sumY += y;
+        _sumYY += y * y;
+    }
+    if (++_sinceAnchor >= STABILITY_WINDOW_SIZE) reanchor();
+    if (_window.full() && !isStable()) _sawMovement = true;
+}
+
+/**
+ * @brief Re-adds the sums from the window, relative to its newest sample.
+ */
+void StabilityDetector::reanchor() {
+    _offset = _window.newest();
+    _sumY = 0.0;
+    _sumYY = 0.0;
+    _sumKY = 0.0;
+    for (size_t k = 0; k < _window.size(); ++k) {
+        double y = _window[k] - _offset;
+        _sumY += y;
+        _sumYY += y * y;
+        _sumKY += k * y;
+    }
+    _sinceAnchor = 0;
+}
+
+/**
+ * @brief The slope (per sample) and residual standard deviation of the
+ * least-squares line through the window. The positions 0..n-1 are fixed,
+ * so their sums are closed-form.
+ */
+void StabilityDetector::fit(double& slope, double& noise) const {
+    slope = 0.0;
+    noise = 0.0;
+    double n = (double)_window.size();
+    if (n < 3) return;
+    double sumK = n * (n - 1.0) / 2.0;
+    double sumKK = (n - 1.0) * n * (2.0 * n - 1.0) / 6.0;
+    double ckk = sumKK - sumK * sumK / n;
+    double cky = _sumKY - sumK * _sumY / n;
+    double cyy = _sumYY - _sumY * _sumY / n;
+    slope = cky / ckk;
+    double residual = (cyy - slope * cky) / (n - 2.0);
+    noise = (residual > 0.0) ? std::sqrt(residual) : 0.0;
+}
+
+double StabilityDetector::getSlope() const {
+    double slope, noise;
+    fit(slope, noise);
+    return slope * 60.0 / _samplePeriod;
+}
+
+double StabilityDetector::getResidualNoise() const {
+    double slope, noise;
+    fit(slope, noise);
+    return noise;
+}
+
+bool StabilityDetector::isStable() const {
+    if (!_window.full()) return false;
+    double slope, noise;
+    fit(slope, noise);
+    return std::fabs(slope * 60.0 / _samplePeriod) <= _criteria.maxSlope && noise <= _criteria.maxNoise;
+}
+
+int StabilityDetector::getStabilityPercentage() const {
+    if (_window.size() < 3) return 0;
+    if (isStable()) return 100;
+    double slope, noise;
+    fit(slope, noise);
+    double slopeRatio = _criteria.maxSlope / std::fmax(std::fabs(slope * 60.0 / _samplePeriod), 1e-9);
+    double noiseRatio = _criteria.maxNoise / std::fmax(noise, 1e-9);
+    double ratio = std::fmin(std::fmin(slopeRatio, noiseRatio), 1.0);
+    int percent = (int)(ratio * 100.0);
+    return (percent > 99) ? 99 : percent;
+}
@@ -0,0 +1,98 @@
+// File Path: /lib/PI_Filter/src/StabilityDetector.h
+// NEW FILE
+
+#ifndef STABILITY_DETECTOR_H
+#define STABILITY_DETECTOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "SampleType.h"
+#include "RingBuffer.h"
+
+// Samples in the slope window; 512 x 22 ms is 11 s. A shorter window lets
+// the slope of a settled, filtered reading wander past 1 mV/min.
+#ifndef STABILITY_WINDOW_SIZE
+#define STABILITY_WINDOW_SIZE 512
+#endif
+
+// Default "stable" criteria. 1 mV/min is about 0.017 pH per minute.
+#ifndef STABILITY_MAX_SLOPE_MV_PER_MIN
+#define STABILITY_MAX_SLOPE_MV_PER_MIN 1.0f
+#endif
+#ifndef STABILITY_MAX_NOISE_MV
+#define STABILITY_MAX_NOISE_MV 0.5f
+#endif
+
+/**
+ * @struct StabilityCriteria
+ * @brief --- NEW: When a reading counts as settled. ---
+ * Floats, so the UI task can change them while the data task reads them.
+ */
+struct StabilityCriteria {
+    float maxSlope = STABILITY_MAX_SLOPE_MV_PER_MIN; // mV per minute, either way
+    float maxNoise = STABILITY_MAX_NOISE_MV;         // Residual std-dev about the trend, mV
+};
+
+/**
+ * @class StabilityDetector
+ * @brief --- NEW: Decides whether a signal has actually stopped moving. ---
+ *
+ * Fits a least-squares line through the last STABILITY_WINDOW_SIZE samples
+ * and reports its slope and the standard deviation of the residuals about
+ * it. The signal is stable once the window is full and both are within the
+ * criteria. Unlike the noise reduction KPI, which compares raw and filtered
+ * noise, this tells a flat reading from one still drifting towards its
+ * endpoint.
+ *
+ * The fit's sums (of y, y^2 and k*y, k being the position in the window)
+ * are updated in O(1) per sample as the window slides. Like the moving
+ * average stage, they are re-added from the window once per lap, so rounding
+ * cannot build up, and they are taken relative to a recent sample to avoid
+ * cancellation. The window itself holds floats, which is plenty for mV and
+ * halves its size in the double build.
+ */
+class StabilityDetector {
+public:
+    explicit StabilityDetector(double samplePeriod = 0.022);
+
+    void push(sample_t value);
+    void reset();
+
+    void setCriteria(const StabilityCriteria& criteria) { _criteria = criteria; }
+    StabilityCriteria getCriteria() const { return _criteria; }
+
+    bool isFull() const { return _window.full(); }
+    double getSlope() const;         // mV per minute
+    double getResidualNoise() const; // mV
+    bool isStable() const;
+
+    /**
+     * @brief How close the signal is to the criteria, for progress bars.
+     * 100 exactly when isStable(); otherwise the tighter of the two ratios
+     * criterion / measured, capped at 99.
+     */
+    int getStabilityPercentage() const;
+
+    /**
+     * @brief True if, since the last reset, a full window has failed the
+     * criteria: the signal has been seen moving, as opposed to sitting
+     * still all along.
+     */
+    bool sawMovement() const { return _sawMovement; }
+
+private:
+    void fit(double& slope, double& noise) const;
+    void reanchor();
+
+    double _samplePeriod;
+    StabilityCriteria _criteria;
+    RingBuffer<float, STABILITY_WINDOW_SIZE> _window;
+    double _offset; // Subtracted from every sample in the sums
+    double _sumY;
+    double _sumYY;
+    double _sumKY;
+    size_t _sinceAnchor;
+    bool _sawMovement;
+};
+
+#endif // STABILITY_DETECTOR_H
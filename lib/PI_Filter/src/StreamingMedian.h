@@ -0,0 +1,251 @@
+// File Path: /lib/PI_Filter/src/StreamingMedian.h
+// MODIFIED FILE
+
+#ifndef STREAMING_MEDIAN_H
+#define STREAMING_MEDIAN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "SampleType.h"
+
+// The largest median window any filter stage may request. All storage is
+// sized for this at compile time so that the hot path never allocates.
+#define MEDIAN_MAX_WINDOW_SIZE 31
+
+/**
+ * @class BasicStreamingMedian
+ * @brief A sliding-window median with O(log n) updates and no heap usage.
+ *
+ * Samples are kept in an arrival-order ring. Each ring slot is indexed by one
+ * of two heaps: a max-heap holding the lower half of the window and a min-heap
+ * holding the upper half. The lower heap always holds exactly size()/2
+ * samples, so the top of the upper heap is element [size()/2] of the sorted
+ * window - the same element the old copy-and-sort implementation returned.
+ *
+ * T is the sample type: sample_t for the floating-point pipeline, or an
+ * integer type for the fixed-point one, where every compare is an integer
+ * compare.
+ */
+template <typename T>
+class BasicStreamingMedian {
+public:
+    BasicStreamingMedian();
+
+    /**
+     * @brief Changes the window size at runtime.
+     * If the window shrinks, the oldest samples are evicted immediately.
+     * This is the one place the output differs from the old copy-and-sort
+     * filter: it pushed one sample and dropped one, so its window stayed at
+     * the old size and a smaller medianWindowSize never took effect.
+     * The size is clamped to [1, MEDIAN_MAX_WINDOW_SIZE].
+     */
+    void setWindowSize(int windowSize);
+    int getWindowSize() const { return _windowSize; }
+
+    /**
+     * @brief Adds a sample, evicting the oldest one if the window is full.
+     * @return The median of the window after the update.
+     */
+    T push(T value);
+
+    T getMedian() const;
+    size_t size() const { return _count; }
+    void clear();
+
+private:
+    void insertSlot(uint8_t slot);
+    void removeSlot(uint8_t slot);
+    void replaceSlot(uint8_t oldSlot, uint8_t newSlot);
+    void rebalance();
+
+    // Heap primitives. 'low' is the max-heap, otherwise the min-heap.
+    bool heapLess(bool low, uint8_t a, uint8_t b) const;
+    void heapSet(bool low, uint8_t pos, uint8_t slot);
+    void siftUp(bool low, uint8_t pos);
+    void siftDown(bool low, uint8_t pos);
+    void heapPush(bool low, uint8_t slot);
+    uint8_t heapPop(bool low);
+    void heapErase(bool low, uint8_t pos);
+
+    T _values[MEDIAN_MAX_WINDOW_SIZE];
+    uint8_t _lowHeap[MEDIAN_MAX_WINDOW_SIZE];
+    uint8_t _highHeap[MEDIAN_MAX_WINDOW_SIZE];
+    uint8_t _heapPos[MEDIAN_MAX_WINDOW_SIZE];
+    bool _inLow[MEDIAN_MAX_WINDOW_SIZE];
+
+    uint8_t _lowCount;
+    uint8_t _highCount;
+    uint8_t _head;   // Ring slot of the oldest sample
+    uint8_t _count;
+    int _windowSize;
+};
+
+typedef BasicStreamingMedian<sample_t> StreamingMedian;
+
+// --- Implementation ---
+
+template <typename T>
+BasicStreamingMedian<T>::BasicStreamingMedian() :
+    _lowCount(0),
+    _highCount(0),
+    _head(0),
+    _count(0),
+    _windowSize(1)
+{}
+
+template <typename T>
+void BasicStreamingMedian<T>::setWindowSize(int windowSize) {
+    if (windowSize < 1) windowSize = 1;
+    if (windowSize > MEDIAN_MAX_WINDOW_SIZE) windowSize = MEDIAN_MAX_WINDOW_SIZE;
+    _windowSize = windowSize;
+
+    // Evict the oldest samples until the window fits.
+    while (_count > _windowSize) {
+        removeSlot(_head);
+        _head = (_head + 1) % MEDIAN_MAX_WINDOW_SIZE;
+        _count--;
+        rebalance();
+    }
+}
+
+template <typename T>
+T BasicStreamingMedian<T>::push(T value) {
+    uint8_t slot = (_head + _count) % MEDIAN_MAX_WINDOW_SIZE;
+    _values[slot] = value;
+
+    if (_count == _windowSize) {
+        // Full window: the new sample takes over the heap entry of the oldest.
+        uint8_t oldest = _head;
+        _head = (_head + 1) % MEDIAN_MAX_WINDOW_SIZE;
+        replaceSlot(oldest, slot);
+    } else {
+        _count++;
+        insertSlot(slot);
+    }
+    return getMedian();
+}
+
+template <typename T>
+T BasicStreamingMedian<T>::getMedian() const {
+    if (_highCount == 0) return T();
+    return _values[_highHeap[0]];
+}
+
+template <typename T>
+void BasicStreamingMedian<T>::clear() {
+    _lowCount = 0;
+    _highCount = 0;
+    _head = 0;
+    _count = 0;
+}
+
+template <typename T>
+void BasicStreamingMedian<T>::insertSlot(uint8_t slot) {
+    bool low = (_highCount > 0 && _values[slot] < _values[_highHeap[0]]);
+    heapPush(low, slot);
+    rebalance();
+}
+
+template <typename T>
+void BasicStreamingMedian<T>::removeSlot(uint8_t slot) {
+    heapErase(_inLow[slot], _heapPos[slot]);
+}
+
+/**
+ * @brief Re-points the heap entry of 'oldSlot' at 'newSlot' and restores order.
+ * Only the replaced entry can violate the heap or the low/high partition, so a
+ * sift in its own heap plus at most one exchange of the two tops is enough.
+ */
+template <typename T>
+void BasicStreamingMedian<T>::replaceSlot(uint8_t oldSlot, uint8_t newSlot) {
+    bool low = _inLow[oldSlot];
+    uint8_t pos = _heapPos[oldSlot];
+    heapSet(low, pos, newSlot);
+    siftUp(low, pos);
+    siftDown(low, _heapPos[newSlot]);
+
+    if (_lowCount > 0 && _values[_lowHeap[0]] > _values[_highHeap[0]]) {
+        uint8_t lowTop = _lowHeap[0];
+        uint8_t highTop = _highHeap[0];
+        heapSet(true, 0, highTop);
+        heapSet(false, 0, lowTop);
+        siftDown(true, 0);
+        siftDown(false, 0);
+    }
+}
+
+template <typename T>
+void BasicStreamingMedian<T>::rebalance() {
+    uint8_t target = _count / 2;
+    while (_lowCount > target) heapPush(false, heapPop(true));
+    while (_lowCount < target) heapPush(true, heapPop(false));
+}
+
+template <typename T>
+bool BasicStreamingMedian<T>::heapLess(bool low, uint8_t a, uint8_t b) const {
+    // True if slot 'a' belongs below slot 'b' in the given heap.
+    return low ? (_values[a] < _values[b]) : (_values[a] > _values[b]);
+}
+
+template <typename T>
+void BasicStreamingMedian<T>::heapSet(bool low, uint8_t pos, uint8_t slot) {
+    if (low) { _lowHeap[pos] = slot; } else { _highHeap[pos] = slot; }
+    _heapPos[slot] = pos;
+    _inLow[slot] = low;
+}
+
+template <typename T>
+void BasicStreamingMedian<T>::siftUp(bool low, uint8_t pos) {
+    uint8_t* heap = low ? _lowHeap : _highHeap;
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!heapLess(low, heap[parent], heap[pos])) break;
+        uint8_t slot = heap[pos];
+        heapSet(low, pos, heap[parent]);
+        heapSet(low, parent, slot);
+        pos = parent;
+    }
+}
+
+template <typename T>
+void BasicStreamingMedian<T>::siftDown(bool low, uint8_t pos) {
+    uint8_t* heap = low ? _lowHeap : _highHeap;
+    uint8_t count = low ? _lowCount : _highCount;
+    for (;;) {
+        uint8_t child = 2 * pos + 1;
+        if (child >= count) break;
+        if (child + 1 < count && heapLess(low, heap[child], heap[child + 1])) child++;
+        if (!heapLess(low, heap[pos], heap[child])) break;
+        uint8_t slot = heap[pos];
+        heapSet(low, pos, heap[child]);
+        heapSet(low, child, slot);
+        pos = child;
+    }
+}
+
+template <typename T>
+void BasicStreamingMedian<T>::heapPush(bool low, uint8_t slot) {
+    uint8_t pos = low ? _lowCount++ : _highCount++;
+    heapSet(low, pos, slot);
+    siftUp(low, pos);
+}
+
+template <typename T>
+uint8_t BasicStreamingMedian<T>::heapPop(bool low) {
+    uint8_t top = low ? _lowHeap[0] : _highHeap[0];
+    heapErase(low, 0);
+    return top;
+}
+
+template <typename T>
+void BasicStreamingMedian<T>::heapErase(bool low, uint8_t pos) {
+    uint8_t* heap = low ? _lowHeap : _highHeap;
+    uint8_t last = low ? --_lowCount : --_highCount;
+    if (pos == last) return;
+    uint8_t moved = heap[last];
+    heapSet(low, pos, moved);
+    siftUp(low, pos);
+    siftDown(low, _heapPos[moved]);
+}
+
+#endif // STREAMING_MEDIAN_H
@@ -78,6 +78,21 @@ void RtcManager::getTimestamp(char* buffer, size_t bufferSize) {
              now.hour(), now.minute(), now.second());
 }
 
+/**
+ * @brief Gets the current time as a Unix timestamp, for staleness checks
+ * on saved state.
+ */
+uint32_t RtcManager::getUnixTime() {
+    if (!_initialized) return 0;
+
+    uint32_t unixTime = 0;
+    if (xSemaphoreTake(_i2cMutex, portMAX_DELAY) == pdTRUE) {
+        unixTime = _rtc.now().unixtime();
+        xSemaphoreGive(_i2cMutex);
+    }
+    return unixTime;
+}
+
 /**
  * @brief Checks if the RTC is running.
  * @return True if the RTC was initialized successfully.
@@ -39,6 +39,12 @@ public:
      */
     void getTimestamp(char* buffer, size_t bufferSize);
 
+    /**
+     * @brief --- NEW: Gets the current time as seconds since 1970. ---
+     * @return The Unix time, or 0 if the RTC is not running.
+     */
+    uint32_t getUnixTime();
+
     /**
      * @brief Checks if the RTC is running and the time is valid.
      * @return True if the RTC is running, false otherwise.
@@ -87,6 +87,41 @@ bool SdManager::remove(const char* path) {
     return success;
 }
 
+bool SdManager::saveBinary(const char* path, const void* data, size_t size) {
+    if (!_isInitialized || _spiMutex == nullptr) return false;
+
+    bool success = false;
+    if (xSemaphoreTake(_spiMutex, portMAX_DELAY) == pdTRUE) {
+        deselectOtherSlaves();
+        FsFile file = sd.open(path, O_WRITE | O_CREAT | O_TRUNC);
+        if (file) {
+            success = file.write((const uint8_t*)data, size) == size;
+            file.sync();
+            file.close();
+        }
+        xSemaphoreGive(_spiMutex);
+    }
+    LOG_STORAGE("SdManager::saveBinary('%s') - %s (%u bytes)", path, success ? "SUCCESS" : "ERROR", (unsigned)size);
+    return success;
+}
+
+size_t SdManager::loadBinary(const char* path, void* data, size_t maxSize) {
+    if (!_isInitialized || _spiMutex == nullptr) return 0;
+
+    size_t bytesRead = 0;
+    if (xSemaphoreTake(_spiMutex, portMAX_DELAY) == pdTRUE) {
+        deselectOtherSlaves();
+        FsFile file = sd.open(path, FILE_READ);
+        if (file) {
+            int result = file.read(data, maxSize);
+            bytesRead = (result > 0) ? (size_t)result : 0;
+            file.close();
+        }
+        xSemaphoreGive(_spiMutex);
+    }
+    return bytesRead;
+}
+
 bool SdManager::takeMutex() {
     if (!_spiMutex) return false;
     return xSemaphoreTake(_spiMutex, portMAX_DELAY) == pdTRUE;
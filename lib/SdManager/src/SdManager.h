@@ -17,6 +17,19 @@ public:
     bool saveJson(const char* path, const JsonDocument& doc) override;
     bool loadJson(const char* path, JsonDocument& doc) override;
     bool mkdir(const char* path);
+
+    /**
+     * @brief --- NEW: Writes a small binary blob, replacing the file. ---
+     * For runtime state that is cheap to lose: a torn write is caught by the
+     * reader's own checks, so there is no temp/backup dance as in saveJson.
+     */
+    bool saveBinary(const char* path, const void* data, size_t size);
+
+    /**
+     * @brief Reads up to 'maxSize' bytes of a binary file.
+     * @return The number of bytes read, or 0 if the file could not be read.
+     */
+    size_t loadBinary(const char* path, void* data, size_t maxSize);
     FsFile open(const char* path, oflag_t oflag);
     bool remove(const char* path);
 
@@ -13,12 +13,15 @@
 #include <ConfigManager.h>
 #include <DisplayManager.h>
 #include <AdcManager.h>
+#include <AcquisitionManager.h>
 #include <SdManager.h>
 #include <TempManager.h>
 #include <RtcManager.h>
 #include <PowerMonitor.h>
 #include <INA219_Driver.h>
 #include <FilterManager.h>
+#include <EndpointPredictor.h>
+#include <HumDetector.h>
 #include <CalibrationManager.h>
 #include "ui/InputManager.h"
 #include "ui/StateManager.h"
@@ -58,6 +61,7 @@ FaultHandler faultHandler;
 ConfigManager configManager;
 DisplayManager displayManager;
 AdcManager adcManager;
+AcquisitionManager acquisition;
 SdManager sdManager;
 TempManager tempManager;
 RtcManager rtcManager;
@@ -100,6 +104,7 @@ void setup() {
     vspi = new SPIClass(VSPI);
     vspi->begin(VSPI_SCK_PIN, VSPI_MISO_PIN, VSPI_MOSI_PIN);
     adcManager.begin(faultHandler, vspi, spiMutex, SD_CS_PIN);
+    acquisition.begin(adcManager);
     sdManager.begin(faultHandler, vspi, spiMutex, SD_CS_PIN, ADC1_CS_PIN, ADC2_CS_PIN);
     sdManager.mkdir("/captures");
     configManager.begin(faultHandler, sdManager);
@@ -186,6 +191,8 @@ void uiTask(void* pvParameters) {
         stateManager->addScreen(ScreenState::TEMP_CALIBRATION, new TempCalibrationScreen());
         stateManager->changeState(ScreenState::MAIN_MENU);
     }
+    // The live voltmeter's own place in the sample stream.
+    SampleCursor voltmeterCursor = acquisition.subscribe();
     for (;;) {
         inputManager.update();
         Screen* activeScreen = stateManager->getActiveScreen();
@@ -208,6 +215,29 @@ void uiTask(void* pvParameters) {
             static_cast<LiveFilterTuningScreen*>(stateManager->getScreen(ScreenState::LIVE_FILTER_TUNING))->update();
         }
 
+        // --- NEW: The voltmeter reads the same sample bus as the data task,
+        // from this task and without conversions of its own. ---
+        if (stateManager->getActiveScreenState() == ScreenState::LIVE_VOLTMETER) {
+            LiveVoltmeterScreen* voltmeter = static_cast<LiveVoltmeterScreen*>(stateManager->getScreen(ScreenState::LIVE_VOLTMETER));
+            if (voltmeter->isMeasuring()) {
+                uint8_t adc_index = voltmeter->getSelectedAdcIndex();
+                uint8_t input = voltmeter->getSelectedAdcInput();
+                // --- NEW: The rails are on the scan already; a probe input
+                // is read on the probe's channel, which has to be woken. ---
+                int channel = acquisition.findChannel(adc_index, input);
+                if (channel < 0) {
+                    acquisition.setInput(adc_index, input);
+                    channel = adc_index;
+                }
+                if (channel < ACQ_PROBE_CHANNELS) adcManager.setProbeState(adc_index, ProbeState::ACTIVE);
+                sample_t readings[ACQ_DRAIN_BATCH];
+                size_t count = acquisition.read(voltmeterCursor, (uint8_t)channel, readings, ACQ_DRAIN_BATCH);
+                if (count > 0) voltmeter->setLiveVoltage(readings[count - 1]);
+            } else {
+                acquisition.flush(voltmeterCursor);
+            }
+        }
+
         if (activeScreen) {
             activeScreen->getRenderProps(&props);
         }
@@ -216,6 +246,159 @@ void uiTask(void* pvParameters) {
     }
 }
 
+/**
+ * @brief --- NEW: Brings a probe's filters up to speed as it is activated. ---
+ * A fast ADC burst is taken first and tested for mains hum, which puts a
+ * notch in the pipeline or takes it out. If a saved state is given and
+ * still matches the probe, the filters warm-start from it; otherwise they
+ * are primed from the end of the burst.
+ */
+static void primeProbeFilter(FilterManager& filter, uint8_t adcIndex, const char* stateName) {
+    // Data task only; static to keep 3 KB off its stack.
+    static double burst[HUM_BURST_SAMPLES];
+    static sample_t samples[HUM_BURST_SAMPLES];
+    double sampleRate = 0.0;
+    size_t count = adcManager.getVoltageBurst(adcIndex, ADS1118::DIFF_0_1, burst, HUM_BURST_SAMPLES, &sampleRate);
+    if (count == 0) return;
+    for (size_t i = 0; i < count; ++i) samples[i] = burst[i];
+    HumReport hum = HumDetector::analyze(samples, count, sampleRate);
+    LOG_FILTER("ADC%u hum: 50 Hz %.3f mV, 60 Hz %.3f mV, noise %.3f mV at %.0f SPS",
+        (unsigned)(adcIndex + 1), hum.amplitude50, hum.amplitude60, hum.noise, sampleRate);
+    filter.setMainsNotch(hum.mainsFrequency, acquisition.getSampleRate());
+    if (stateName && configManager.loadFilterState(filter, stateName, rtcManager.getUnixTime(), samples[count - 1])) {
+        return;
+    }
+    size_t primeCount = (count > ADC_BURST_SAMPLES) ? ADC_BURST_SAMPLES : count;
+    filter.prime(samples + count - primeCount, primeCount);
+}
+
+/**
+ * @brief --- NEW: Feeds the endpoint predictor for the probe being measured. ---
+ * It fits the HF stage's output: the LF stage adds a lag of its own that
+ * grows as it locks, so its output is not a single exponential. The
+ * fixed-point build does not run the floating-point stages, and fits the
+ * raw reading instead; so does a pipeline with a Hampel stage as HF.
+ */
+static void feedEndpoint(EndpointPredictor& endpoint, FilterManager& filter, sample_t raw_mv) {
+#if PIPELINE_FIXED_POINT == 1
+    endpoint.push(raw_mv);
+#else
+    PI_Filter* hf = filter.getFilter(0);
+    endpoint.push(hf ? hf->getFilteredValue() : raw_mv);
+#endif
+}
+
+// The filter of each acquisition channel, by ACQ_CH_*; the temperature has none.
+static FilterManager* const channelFilters[ACQ_CH_TEMPERATURE + 1] = {
+    &phFilter, &ecFilter, &v3_3_Filter, &v5_0_Filter, nullptr
+};
+// The rails are filtered on every tick, whatever the screen.
+#define ACQ_RAIL_CHANNELS ((1u << ACQ_CH_RAIL_3V3) | (1u << ACQ_CH_RAIL_5V))
+
+/**
+ * @brief --- NEW: Restarts the filters a lapped pass fed. ---
+ * An active probe is re-primed from a fresh burst, as on activation; a rail
+ * restarts at its last output. What was queued meanwhile is dropped.
+ */
+static void recoverFromLap(SampleCursor& cursor, uint32_t channels) {
+    LOG_FILTER("Data task lapped by the acquisition task (%lu samples lost in all), re-priming",
+        (unsigned long)cursor.overruns);
+    for (uint8_t channel = 0; channel < ACQ_CH_TEMPERATURE; ++channel) {
+        FilterManager* filter = channelFilters[channel];
+        if (!(channels & (1u << channel)) || filter->getChannel() < 0) continue;
+        if (channel < ACQ_PROBE_CHANNELS) {
+            if (adcManager.isProbeActive(channel)) primeProbeFilter(*filter, channel, nullptr);
+        } else {
+            sample_t level = filter->getOutput();
+            filter->prime(&level, 1);
+        }
+    }
+    acquisition.flush(cursor);
+}
+
+/**
+ * @brief --- NEW: Runs the unread samples through the FilterBank, one pass
+ * per acquisition tick. ---
+ * Every record on the cursor is taken, read in place. The channels in
+ * 'channels' (a bit per acquisition channel) are filtered together: a bank
+ * pass runs as soon as one of them turns up again, so a probe and both
+ * rails advance in step. After each pass, onSample(channel, raw, filtered)
+ * is called for every channel the pass advanced. Other channels, and
+ * records taken on a since-switched input, are passed over. The
+ * fixed-point build runs the probes through processCounts() instead.
+ * @return False if the acquisition task lapped the cursor while the records
+ * were in use. Some of what was filtered may then have been torn, so the
+ * filters are re-primed (see recoverFromLap) and the caller should drop the
+ * pass's readings and restart its predictor.
+ */
+template <typename OnSample>
+static bool filterTicks(SampleCursor& cursor, uint32_t channels, OnSample onSample) {
+    FilterBank& bank = FilterBank::instance();
+    sample_t bankIn[FILTER_BANK_CHANNELS] = {0};
+    sample_t bankOut[FILTER_BANK_CHANNELS];
+    sample_t raw[ACQ_CH_TEMPERATURE + 1];
+    uint32_t bankMask = 0; // Bank channels in the pending pass
+    uint32_t pending = 0;  // Their acquisition channels
+    auto runPass = [&]() {
+        bank.process(bankIn, bankOut, bankMask);
+        for (uint8_t channel = 0; channel <= ACQ_CH_TEMPERATURE; ++channel) {
+            if (pending & (1u << channel)) onSample(channel, raw[channel], bankOut[channelFilters[channel]->getChannel()]);
+        }
+        bankMask = 0;
+        pending = 0;
+    };
+
+    const SampleRecord* records;
+    size_t count = acquisition.peek(cursor, records);
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t channel = records[i].channel;
+        if (channel > ACQ_CH_TEMPERATURE || !(channels & (1u << channel))) continue;
+        FilterManager* filter = channelFilters[channel];
+        if (!filter || filter->getChannel() < 0 || !acquisition.isCurrent(records[i])) continue;
+#if PIPELINE_FIXED_POINT == 1
+        if (channel < ACQ_PROBE_CHANNELS) {
+            float mv_per_count = acquisition.getMilliVoltsPerCount(channel);
+            onSample(channel, records[i].rawCount * mv_per_count, filter->processCounts(records[i].rawCount, mv_per_count));
+            continue;
+        }
+#endif
+        if (bankMask & filter->getChannelMask()) runPass();
+        raw[channel] = acquisition.toMilliVolts(records[i]);
+        bankIn[filter->getChannel()] = raw[channel];
+        bankMask |= filter->getChannelMask();
+        pending |= 1u << channel;
+    }
+    if (bankMask) runPass();
+    if (acquisition.consume(cursor, count)) return true;
+    recoverFromLap(cursor, channels);
+    return false;
+}
+
+/**
+ * @brief --- NEW: Fills 'samples' with the next 'count' samples of a probe
+ * from the acquisition ring, calling progress(percent) as it goes. ---
+ * Gives up if no sample arrives for a second (the probe went dormant or
+ * its ADC stopped answering).
+ * @return The number of samples taken; 'timestamps' gets their times.
+ */
+template <typename Progress>
+static size_t captureProbe(uint8_t adcIndex, sample_t* samples, uint32_t* timestamps, size_t count, Progress progress) {
+    // A cursor of its own, starting now.
+    SampleCursor cursor = acquisition.subscribe();
+    size_t taken = 0;
+    uint32_t lastSample = millis();
+    while (taken < count && millis() - lastSample < 1000) {
+        size_t got = acquisition.read(cursor, adcIndex, samples + taken, count - taken, timestamps ? timestamps + taken : nullptr);
+        if (got > 0) {
+            taken += got;
+            lastSample = millis();
+            progress((int)(taken * 100 / count));
+        }
+        vTaskDelay(pdMS_TO_TICKS(22));
+    }
+    return taken;
+}
+
 /**
  * @brief The main data processing task.
  * @version 3.1.13
@@ -225,6 +408,14 @@ void dataTask(void* pvParameters) {
     LOG_BOOT("Data Task started on Core %d", xPortGetCoreID());
 
     ScreenState lastState = ScreenState::NONE;
+    // The filter being measured with, so its state is saved when the screen exits.
+    FilterManager* warmStartFilter = nullptr;
+    const char* warmStartName = nullptr;
+    // Where the active probe is settling, restarted with every screen and
+    // calibration point.
+    EndpointPredictor endpoint(acquisition.getPeriodUs() / 1e6, ENDPOINT_TOLERANCE_MV);
+    // The data task's place in the sample stream.
+    SampleCursor cursor = acquisition.subscribe();
 
     for (;;) {
         if (!stateManager) { vTaskDelay(pdMS_TO_TICKS(100)); continue; }
@@ -232,6 +423,11 @@ void dataTask(void* pvParameters) {
         Screen* activeScreen = stateManager->getActiveScreen();
 
         if (currentState != lastState) {
+            endpoint.reset();
+            if (warmStartFilter) {
+                configManager.saveFilterState(*warmStartFilter, warmStartName, rtcManager.getUnixTime());
+                warmStartFilter = nullptr;
+            }
             adcManager.setProbeState(0, ProbeState::DORMANT);
             adcManager.setProbeState(1, ProbeState::DORMANT);
 
@@ -239,12 +435,20 @@ void dataTask(void* pvParameters) {
                 if (currentState == ScreenState::CALIBRATION_MENU) {
                     adcManager.setProbeState(0, ProbeState::ACTIVE);
                     adcManager.setProbeState(1, ProbeState::ACTIVE);
+                    primeProbeFilter(phFilter, 0, nullptr);
+                    primeProbeFilter(ecFilter, 1, nullptr);
                 }
                 else if (currentState == ScreenState::PROBE_MEASUREMENT) {
                     ProbeMeasurementScreen* screen = static_cast<ProbeMeasurementScreen*>(activeScreen);
                     if (screen) {
                         uint8_t probe_index = (screen->getActiveProbeType() == ProbeType::PH) ? 0 : 1;
                         adcManager.setProbeState(probe_index, ProbeState::ACTIVE);
+                        // Warm start: resume where the last measurement left
+                        // off if the saved state still matches the probe,
+                        // otherwise prime from a burst.
+                        warmStartFilter = (probe_index == 0) ? &phFilter : &ecFilter;
+                        warmStartName = (probe_index == 0) ? "ph_filter" : "ec_filter";
+                        primeProbeFilter(*warmStartFilter, probe_index, warmStartName);
                     }
                 } else if (currentState == ScreenState::CALIBRATION_WIZARD) {
                     CalibrationWizardScreen* screen = static_cast<CalibrationWizardScreen*>(activeScreen);
@@ -252,6 +456,7 @@ void dataTask(void* pvParameters) {
                         uint8_t probe_index = (screen->getProbeType() == ProbeType::PH) ? 0 : 1;
                         adcManager.setProbeState(probe_index, ProbeState::ACTIVE);
                         adcManager.setProbeState(1 - probe_index, ProbeState::DORMANT); 
+                        primeProbeFilter((probe_index == 0) ? phFilter : ecFilter, probe_index, nullptr);
                     }
                 }
             } else if (mode == BootMode::PBIOS) {
@@ -261,9 +466,12 @@ void dataTask(void* pvParameters) {
                      currentState == ScreenState::DRIFT_TRENDING ||
                      currentState == ScreenState::LIVE_VOLTMETER ||
                      currentState == ScreenState::PROBE_PROFILING) {
+                    acquisition.setInput(pBiosContext.selectedAdcIndex, pBiosContext.selectedAdcInput);
                     adcManager.setProbeState(pBiosContext.selectedAdcIndex, ProbeState::ACTIVE);
                  }
             }
+            // Whatever was queued belongs to the last screen.
+            acquisition.flush(cursor);
             lastState = currentState;
         }
 
@@ -282,10 +490,20 @@ void dataTask(void* pvParameters) {
                     // --- Use the new centralized method for the diagnostic log ---
                     int stability = filter->getNoiseReductionPercentage();
                     LOG_DIAG("--- Normal Boot Filter Report ---");
-                    LOG_DIAG("HF Setpoints: Settle=%.3f, Smooth=%.3f", filter->getFilter(0)->settleThreshold, filter->getFilter(0)->lockSmoothing);
-                    LOG_DIAG("LF Setpoints: Settle=%.3f, Smooth=%.3f", filter->getFilter(1)->settleThreshold, filter->getFilter(1)->lockSmoothing);
-                    LOG_DIAG("Live Stats: Raw_std=%.4f, LF_out_std=%.4f", filter->getFilter(0)->getRawStandardDeviation(), filter->getFilter(1)->getFilteredStandardDeviation());
+                    FilterParams hfParams = filter->getParams(0);
+                    FilterParams lfParams = filter->getParams(1);
+                    PI_Filter* hfFilter = filter->getFilter(0);
+                    PI_Filter* lfFilter = filter->getFilter(1);
+                    // A Hampel stage in the HF role has no PI setpoints.
+                    if (filter->hasPIStage(0)) {
+                        LOG_DIAG("HF Setpoints: Settle=%.3f, Smooth=%.3f", hfParams.settleThreshold, hfParams.lockSmoothing);
+                    } else {
+                        LOG_DIAG("HF Setpoints: none (Hampel stage)");
+                    }
+                    LOG_DIAG("LF Setpoints: Settle=%.3f, Smooth=%.3f", lfParams.settleThreshold, lfParams.lockSmoothing);
+                    LOG_DIAG("Live Stats: Raw_std=%.4f, LF_out_std=%.4f", hfFilter ? hfFilter->getRawStandardDeviation() : 0.0, lfFilter ? lfFilter->getFilteredStandardDeviation() : 0.0);
                     LOG_DIAG("Final Noise Reduction: %d %%", stability);
+                    LOG_DIAG("Rails (filtered): 3.3V=%.2f mV, 5V=%.2f mV", v3_3_Filter.getOutput(), v5_0_Filter.getOutput());
                     LOG_DIAG("---------------------------------");
                 }
             }
@@ -294,32 +512,66 @@ void dataTask(void* pvParameters) {
 
         if (mode == BootMode::NORMAL) {
             if(currentState == ScreenState::CALIBRATION_MENU) {
-                if(adcManager.isProbeActive(0)) phFilter.process(adcManager.getVoltage(0, ADS1118::DIFF_0_1));
-                if(adcManager.isProbeActive(1)) ecFilter.process(adcManager.getVoltage(1, ADS1118::DIFF_0_1));
+                // Both probes stay warm for the wizard.
+                filterTicks(cursor, (1u << ACQ_CH_PH) | (1u << ACQ_CH_EC) | ACQ_RAIL_CHANNELS,
+                            [](uint8_t, sample_t, sample_t) {});
             }
             else if (currentState == ScreenState::PROBE_MEASUREMENT) {
                 ProbeMeasurementScreen* screen = static_cast<ProbeMeasurementScreen*>(activeScreen);
-                if (screen) {
-                    ProbeType type = screen->getActiveProbeType();
-                    uint8_t adc_index = (type == ProbeType::PH) ? 0 : 1;
-                    FilterManager* filter = (type == ProbeType::PH) ? &phFilter : &ecFilter;
-                    CalibrationManager* calManager = (type == ProbeType::PH) ? &phCalManager : &ecCalManager;
-                    double raw_mv = adcManager.getVoltage(adc_index, ADS1118::DIFF_0_1);
-                    double filtered_mv = filter->process(raw_mv);
-                    double cal_value = calManager->getCalibratedValue(filtered_mv);
-                    double temp = tempManager.getProbeTemp();
-                    double final_value = calManager->getCompensatedValue(cal_value, temp, type == ProbeType::EC);
+                // Every tick since the last pass goes through the bank and
+                // the predictor; the screen shows the last.
+                ProbeType type = screen ? screen->getActiveProbeType() : ProbeType::PH;
+                uint8_t adc_index = (type == ProbeType::PH) ? 0 : 1;
+                FilterManager* filter = (type == ProbeType::PH) ? &phFilter : &ecFilter;
+                CalibrationManager* calManager = (type == ProbeType::PH) ? &phCalManager : &ecCalManager;
+                size_t fresh = 0;
+                sample_t raw_mv = 0, filtered_mv = 0;
+                uint32_t channels = screen ? (1u << adc_index) | ACQ_RAIL_CHANNELS : ACQ_RAIL_CHANNELS;
+                bool intact = filterTicks(cursor, channels, [&](uint8_t channel, sample_t raw, sample_t filtered) {
+                    if (channel != adc_index) return;
+                    fresh++;
+                    raw_mv = raw;
+                    filtered_mv = filtered;
+                    feedEndpoint(endpoint, *filter, raw);
+                });
+                if (!intact) {
+                    endpoint.reset();
+                    fresh = 0;
+                }
+                if (fresh > 0) {
+                    sample_t cal_value = calManager->getCalibratedValue(filtered_mv);
+                    sample_t temp = tempManager.getProbeTemp();
+                    sample_t final_value = calManager->getCompensatedValue(cal_value, temp, type == ProbeType::EC);
+
+                    const EndpointEstimate& estimate = endpoint.getEstimate();
+                    sample_t predicted_value = NAN;
+                    if (estimate.valid) {
+                        predicted_value = calManager->getCompensatedValue(calManager->getCalibratedValue(estimate.value), temp, type == ProbeType::EC);
+                    }
+                    screen->setPrediction(endpoint.isReady(), predicted_value, estimate.valid ? estimate.timeToSettle : 0.0);
                     
                     // --- DEFINITIVE FIX: Use the new centralized method ---
+#if PIPELINE_FIXED_POINT == 1
+                    int stability = filter->getFixedNoiseReductionPercentage();
+#else
                     int stability = filter->getNoiseReductionPercentage();
+#endif
 
                     screen->updateData(final_value, temp, stability, raw_mv, filtered_mv);
                     if (screen->captureWasRequested()) {
+                        // "Accept" captures the predicted reading instead of the live one.
+                        bool predicted = screen->acceptWasRequested() && !isnan(predicted_value);
                         StaticJsonDocument<1024> doc;
                         doc["timestamp"] = g_sessionTimestamp;
                         JsonObject reading = doc.createNestedObject("reading");
                         reading["probeType"] = (type == ProbeType::PH) ? "pH" : "EC";
-                        reading["value"] = final_value;
+                        reading["value"] = predicted ? predicted_value : final_value;
+                        reading["predicted"] = predicted;
+                        if (predicted) {
+                            reading["live_value"] = final_value;
+                            reading["predicted_mV"] = estimate.value;
+                            reading["prediction_band_mV"] = estimate.band;
+                        }
                         reading["temperature"] = temp;
                         reading["stability"] = stability;
                         reading["raw_mV"] = raw_mv;
@@ -328,8 +580,8 @@ void dataTask(void* pvParameters) {
                         system["soc"] = powerMonitor.getSOC();
                         system["soh"] = powerMonitor.getSOH();
                         JsonObject filterSettings = doc.createNestedObject("filter_settings");
-                        filterSettings["hf_settle"] = filter->getFilter(0)->settleThreshold;
-                        filterSettings["lf_settle"] = filter->getFilter(1)->settleThreshold;
+                        if (filter->hasPIStage(0)) filterSettings["hf_settle"] = filter->getParams(0).settleThreshold;
+                        if (filter->hasPIStage(1)) filterSettings["lf_settle"] = filter->getParams(1).settleThreshold;
                         JsonObject calModel = doc.createNestedObject("calibration_model");
                         calManager->serializeModel(calManager->getCurrentModel(), calModel);
                         char filepath[64];
@@ -341,20 +593,46 @@ void dataTask(void* pvParameters) {
             }
             else if (currentState == ScreenState::CALIBRATION_WIZARD) {
                 CalibrationWizardScreen* screen = static_cast<CalibrationWizardScreen*>(activeScreen);
+                // The probe's samples are only wanted while a point is being measured.
+                if (!screen || !screen->isMeasuring()) {
+                    filterTicks(cursor, ACQ_RAIL_CHANNELS, [](uint8_t, sample_t, sample_t) {});
+                }
                 if (screen && screen->isMeasuring()) {
                     ProbeType type = screen->getProbeType();
                     uint8_t adc_index = (type == ProbeType::PH) ? 0 : 1;
                     FilterManager* filter = (type == ProbeType::PH) ? &phFilter : &ecFilter;
                     CalibrationManager* calManager = (type == ProbeType::PH) ? &phCalManager : &ecCalManager;
-                    double raw_voltage = adcManager.getVoltage(adc_index, ADS1118::DIFF_0_1);
-                    filter->process(raw_voltage);
+                    size_t fresh = 0;
+                    sample_t pipeline_output = NAN;
+                    bool intact = filterTicks(cursor, (1u << adc_index) | ACQ_RAIL_CHANNELS, [&](uint8_t channel, sample_t raw, sample_t filtered) {
+                        if (channel != adc_index) return;
+                        fresh++;
+                        pipeline_output = filtered;
+                        feedEndpoint(endpoint, *filter, raw);
+                    });
+                    if (!intact) {
+                        endpoint.reset();
+                        fresh = 0;
+                    }
                     
-                    // --- DEFINITIVE FIX: Use the new centralized method ---
-                    int stability = filter->getNoiseReductionPercentage();
-                    screen->setLiveStability(stability);
+                    // Slope-based: 100 only once the output is actually flat.
+                    screen->setLiveStability(filter->getStabilityPercentage());
+
+                    // Once the predictor has followed the probe into this
+                    // buffer and is sure of the endpoint, the point is
+                    // captured at the predicted voltage without waiting for
+                    // the filters to get there. Failing that, it is captured
+                    // as soon as the output has moved and gone flat. A probe
+                    // that was already settled when the step began is left
+                    // to the user.
+                    const EndpointEstimate& estimate = endpoint.getEstimate();
+                    screen->setTimeToSettle(estimate.valid ? estimate.timeToSettle : 0.0);
+                    bool predictedCapture = endpoint.isReady() && endpoint.sawApproach();
+                    const StabilityDetector* detector = filter->getStabilityDetector();
+                    bool settledCapture = detector && detector->isStable() && detector->sawMovement();
 
-                    if (screen->pointCaptureWasRequested()) {
-                        double filtered_voltage = filter->getFilter(1)->getFilteredValue();
+                    if (fresh > 0 && (screen->pointCaptureWasRequested() || predictedCapture || settledCapture)) {
+                        double filtered_voltage = predictedCapture ? estimate.value : pipeline_output;
                         float temperature = tempManager.getProbeTemp();
                         double known_value = 0.0;
                         if(type == ProbeType::PH) {
@@ -367,6 +645,8 @@ void dataTask(void* pvParameters) {
                         calManager->addCalibrationPoint(filtered_voltage, known_value, temperature);
                         screen->clearPointCaptureRequest();
                         screen->advanceToNextStep();
+                        endpoint.reset();
+                        filter->resetStability();
                         if (screen->getCurrentStep() > 3) {
                             screen->transitionToCalculating();
                         }
@@ -391,22 +671,73 @@ void dataTask(void* pvParameters) {
                     stateManager->changeState(ScreenState::CALIBRATION_MENU);
                 }
             }
+            else if (currentState == ScreenState::PROBE_HEALTH_CHECK) {
+                ProbeHealthCheckScreen* screen = static_cast<ProbeHealthCheckScreen*>(activeScreen);
+                if (screen && screen->isMeasuring()) {
+                    ProbeType type = screen->getProbeType();
+                    uint8_t adc_index = (type == ProbeType::PH) ? 0 : 1;
+                    FilterManager* filter = (type == ProbeType::PH) ? &phFilter : &ecFilter;
+                    CalibrationManager* calManager = (type == ProbeType::PH) ? &phCalManager : &ecCalManager;
+                    // The probe is chosen on the screen itself, so it is
+                    // woken here rather than on the state change.
+                    if (!adcManager.isProbeActive(adc_index)) {
+                        adcManager.setProbeState(adc_index, ProbeState::ACTIVE);
+                        primeProbeFilter(*filter, adc_index, nullptr);
+                    }
+                    size_t fresh = 0;
+                    sample_t filtered_mv = NAN;
+                    bool intact = filterTicks(cursor, (1u << adc_index) | ACQ_RAIL_CHANNELS, [&](uint8_t channel, sample_t, sample_t filtered) {
+                        if (channel != adc_index) return;
+                        fresh++;
+                        filtered_mv = filtered;
+                    });
+                    if (!intact) fresh = 0;
+                    screen->setLiveStability(filter->getStabilityPercentage());
+
+                    // Checked as soon as the reading has moved into the
+                    // buffer and gone flat, or on request once it is flat.
+                    const StabilityDetector* detector = filter->getStabilityDetector();
+                    bool stable = fresh > 0 && detector && detector->isStable();
+                    if (stable && (detector->sawMovement() || screen->checkWasRequested())) {
+                        sample_t temp = tempManager.getProbeTemp();
+                        double reading = calManager->getCompensatedValue(calManager->getCalibratedValue(filtered_mv), temp, type == ProbeType::EC);
+                        double reference = (type == ProbeType::PH) ? HEALTH_CHECK_PH_REFERENCE : HEALTH_CHECK_EC_REFERENCE;
+                        double error = fabs(reading - reference) / reference;
+                        double health = 100.0 * (1.0 - error / HEALTH_CHECK_ZERO_HEALTH_ERROR);
+                        screen->setResult(health < 0.0 ? 0.0 : health);
+                        adcManager.setProbeState(adc_index, ProbeState::DORMANT);
+                    }
+                } else {
+                    if (screen) {
+                        adcManager.setProbeState(0, ProbeState::DORMANT);
+                        adcManager.setProbeState(1, ProbeState::DORMANT);
+                    }
+                    filterTicks(cursor, ACQ_RAIL_CHANNELS, [](uint8_t, sample_t, sample_t) {});
+                }
+            }
+            else {
+                filterTicks(cursor, ACQ_RAIL_CHANNELS, [](uint8_t, sample_t, sample_t) {});
+            }
         } else if (mode == BootMode::PBIOS) {
             switch (currentState) {
                 case ScreenState::LIVE_FILTER_TUNING:
                 case ScreenState::PARAMETER_EDIT:
                      if (pBiosContext.selectedFilter) {
-                        double raw_voltage = adcManager.getVoltage(pBiosContext.selectedAdcIndex, pBiosContext.selectedAdcInput);
-                        pBiosContext.selectedFilter->process(raw_voltage);
+                        sample_t samples[ACQ_DRAIN_BATCH];
+                        size_t count = acquisition.read(cursor, pBiosContext.selectedAdcIndex, samples, ACQ_DRAIN_BATCH);
+                        if (count > 0) {
+                            pBiosContext.selectedFilter->process(samples, samples, count);
+                            pBiosContext.selectedFilter->publishSnapshot();
+                        }
                      }
                     break;
                 case ScreenState::AUTO_TUNE_RUNNING: {
                     AutoTuningScreen* tuneScreen = static_cast<AutoTuningScreen*>(activeScreen);
                     if (tuneScreen && pBiosContext.selectedFilter) {
+                        acquisition.setInput(pBiosContext.selectedAdcIndex, pBiosContext.selectedAdcInput);
                         adcManager.setProbeState(pBiosContext.selectedAdcIndex, ProbeState::ACTIVE);
                         vTaskDelay(pdMS_TO_TICKS(100)); 
-                        adcManager.getVoltage(pBiosContext.selectedAdcIndex, pBiosContext.selectedAdcInput); 
-                        if (guidedTuningEngine.proposeSettings(pBiosContext, adcManager, sdManager, stateManager, *tuneScreen)) {
+                        if (guidedTuningEngine.proposeSettings(pBiosContext, acquisition, sdManager, stateManager, *tuneScreen)) {
                             configManager.saveFilterSettings(*pBiosContext.selectedFilter, pBiosContext.selectedFilterName.c_str(), g_sessionTimestamp, false);
                         }
                         tuneScreen->setProgress(100, "Finalizing...");
@@ -418,23 +749,27 @@ void dataTask(void* pvParameters) {
                 case ScreenState::PROBE_PROFILING: {
                     ProbeProfilingScreen* screen = static_cast<ProbeProfilingScreen*>(activeScreen);
                     if (screen && screen->isAnalyzing()) {
-                        for (int i = 0; i < 50; i++) {
-                             double voltage = adcManager.getVoltage(screen->getSelectedAdcIndex(), screen->getSelectedAdcInput());
-                             phFilter.process(voltage);
-                             screen->setProgress((i*100)/50);
-                             vTaskDelay(pdMS_TO_TICKS(22));
-                        }
                         FilterManager* filterToProfile = (screen->getSelectedAdcIndex() == 0) ? &phFilter : &ecFilter;
+                        // Capture first, then run the whole capture through the
+                        // pipeline in one batch.
+                        sample_t profile_samples[PROFILING_SAMPLE_COUNT];
+                        uint32_t profile_times[PROFILING_SAMPLE_COUNT];
+                        acquisition.setInput(screen->getSelectedAdcIndex(), screen->getSelectedAdcInput());
+                        adcManager.setProbeState(screen->getSelectedAdcIndex(), ProbeState::ACTIVE);
+                        size_t taken = captureProbe(screen->getSelectedAdcIndex(), profile_samples, profile_times, PROFILING_SAMPLE_COUNT,
+                                                    [screen](int percent) { screen->setProgress(percent); });
+                        filterToProfile->process(profile_samples, profile_samples, taken);
                         CalibrationManager* calManagerToUse = (screen->getSelectedAdcIndex() == 0) ? &phCalManager : &ecCalManager;
                         const CalibrationModel& model = calManagerToUse->getCurrentModel();
-                        double live_r_std = filterToProfile->getFilter(0)->getRawStandardDeviation();
+                        PI_Filter* hfFilter = filterToProfile->getFilter(0);
+                        double live_r_std = hfFilter ? hfFilter->getRawStandardDeviation() : 0.0;
                         double zp_drift = model.zeroPointDrift;
                         double cal_quality = model.qualityScore;
                         char time_buf[20];
                         strftime(time_buf, sizeof(time_buf), "%Y%m%d-%H%M%S", localtime(&model.lastCalibratedTimestamp));
                         screen->setAnalysisResults(live_r_std,
-                                                   *filterToProfile->getFilter(0),
-                                                   *filterToProfile->getFilter(1),
+                                                   filterToProfile->getParams(0),
+                                                   filterToProfile->getParams(1),
                                                    zp_drift,
                                                    cal_quality,
                                                    std::string(time_buf));
@@ -444,16 +779,12 @@ void dataTask(void* pvParameters) {
                 case ScreenState::NOISE_ANALYSIS: {
                     NoiseAnalysisScreen* screen = static_cast<NoiseAnalysisScreen*>(activeScreen);
                     if (screen && screen->isSampling()) {
-                        std::vector<double> samples;
-                        samples.reserve(ANALYSIS_SAMPLE_COUNT);
-                        for (int i = 0; i < ANALYSIS_SAMPLE_COUNT; ++i) {
-                            double voltage = adcManager.getVoltage(pBiosContext.selectedAdcIndex, pBiosContext.selectedAdcInput);
-                            if (!isnan(voltage)) {
-                                samples.push_back(voltage);
-                            }
-                            screen->setSamplingProgress((i * 100) / ANALYSIS_SAMPLE_COUNT);
-                            vTaskDelay(pdMS_TO_TICKS(22));
-                        }
+                        // Data task only; static to keep the capture off its stack.
+                        static sample_t captured[ANALYSIS_SAMPLE_COUNT];
+                        static uint32_t times[ANALYSIS_SAMPLE_COUNT];
+                        size_t taken = captureProbe(pBiosContext.selectedAdcIndex, captured, times, ANALYSIS_SAMPLE_COUNT,
+                                                    [screen](int percent) { screen->setSamplingProgress(percent); });
+                        std::vector<double> samples(captured, captured + taken);
                         if (!samples.empty()) {
                             double sum = std::accumulate(samples.begin(), samples.end(), 0.0);
                             double mean = sum / samples.size();
@@ -470,19 +801,13 @@ void dataTask(void* pvParameters) {
                     if (screen && screen->isSampling()) {
                         long duration_ms = screen->getSelectedDurationSec() * 1000;
                         long start_time = millis();
-                        std::vector<double> samples;
-                        samples.reserve(DRIFT_SAMPLE_COUNT);
                         double fft_real[DRIFT_SAMPLE_COUNT];
                         double fft_imag[DRIFT_SAMPLE_COUNT];
-
-                        for (int i = 0; i < DRIFT_SAMPLE_COUNT; ++i) {
-                            double voltage = adcManager.getVoltage(pBiosContext.selectedAdcIndex, pBiosContext.selectedAdcInput);
-                            if (!isnan(voltage)) {
-                                samples.push_back(voltage);
-                            }
-                            screen->setSamplingProgress((i * 100) / DRIFT_SAMPLE_COUNT);
-                            vTaskDelay(pdMS_TO_TICKS(22));
-                        }
+                        static sample_t captured[DRIFT_SAMPLE_COUNT];
+                        static uint32_t times[DRIFT_SAMPLE_COUNT];
+                        size_t taken = captureProbe(pBiosContext.selectedAdcIndex, captured, times, DRIFT_SAMPLE_COUNT,
+                                                    [screen](int percent) { screen->setSamplingProgress(percent); });
+                        std::vector<double> samples(captured, captured + taken);
 
                         screen->setAnalyzing();
                         vTaskDelay(pdMS_TO_TICKS(100));
@@ -494,7 +819,9 @@ void dataTask(void* pvParameters) {
                                 fft_real[i] = samples[i] - mean;
                                 fft_imag[i] = 0.0;
                             }
-                            arduinoFFT fft(fft_real, fft_imag, DRIFT_SAMPLE_COUNT, 1000.0 / 22.0);
+                            // The frequency axis comes from when the samples were
+                            // actually taken.
+                            arduinoFFT fft(fft_real, fft_imag, DRIFT_SAMPLE_COUNT, acquisition.measuredRate(times, taken));
                             fft.Windowing(FFT_WIN_TYP_HAMMING, FFT_FORWARD);
                             fft.Compute(FFT_FORWARD);
                             fft.ComplexToMagnitude();
@@ -515,7 +842,9 @@ void dataTask(void* pvParameters) {
             currentState == ScreenState::PROBE_PROFILING ||
             currentState == ScreenState::CALIBRATION_MENU ||
             currentState == ScreenState::CALIBRATION_WIZARD) {
-            vTaskDelay(pdMS_TO_TICKS(22)); 
+            // The samples are taken on the acquisition task's grid; this
+            // only sets how often they are collected from the ring.
+            vTaskDelay(pdMS_TO_TICKS(22));
         } else {
             vTaskDelay(pdMS_TO_TICKS(50)); 
         }
@@ -24,11 +24,11 @@ struct PBiosContext {
 
     // --- Auto-Tuner Wizard State ---
     // A snapshot of the filter parameters at the beginning of the tuning pass.
-    PI_Filter hf_params_snapshot;
-    PI_Filter lf_params_snapshot;
+    FilterParams hf_params_snapshot;
+    FilterParams lf_params_snapshot;
     
     // The raw signal data captured during the analysis stage.
-    std::vector<double> captured_samples;
+    std::vector<sample_t> captured_samples;
 
     // The results of the signal characterization.
     double raw_std_dev = 0.0;
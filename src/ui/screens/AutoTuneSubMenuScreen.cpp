@@ -48,8 +48,8 @@ void AutoTuneSubMenuScreen::handleInput(const InputEvent& event) {
         if (selected_item == "Tuner Wizard") {
             if (_stateManager && pBiosContext.selectedFilter) {
                 // Take a snapshot of the current parameters for the "Restore" feature
-                pBiosContext.hf_params_snapshot = *pBiosContext.selectedFilter->getFilter(0);
-                pBiosContext.lf_params_snapshot = *pBiosContext.selectedFilter->getFilter(1);
+                pBiosContext.hf_params_snapshot = pBiosContext.selectedFilter->getParams(0);
+                pBiosContext.lf_params_snapshot = pBiosContext.selectedFilter->getParams(1);
 
                 // Transition to the screen that shows the progress bar
                 _stateManager->changeState(ScreenState::AUTO_TUNE_RUNNING);
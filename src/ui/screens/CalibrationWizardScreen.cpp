@@ -21,6 +21,7 @@ CalibrationWizardScreen::CalibrationWizardScreen() :
     _wizard_state(WizardState::INTRODUCTION),
     _current_step(1),
     _live_stability_percent(0),
+    _seconds_to_settle(0.0),
     _point_capture_requested(false), // Initialize new flag
     _save_requested(false),
     _result_quality_score(0.0),
@@ -39,6 +40,7 @@ void CalibrationWizardScreen::onEnter(StateManager* stateManager, int context) {
     _wizard_state = WizardState::INTRODUCTION;
     _current_step = 1;
     _live_stability_percent = 0;
+    _seconds_to_settle = 0.0;
     _point_capture_requested = false; // Reset on entry
     _save_requested = false;
 
@@ -97,11 +99,18 @@ void CalibrationWizardScreen::getRenderProps(UIRenderProps* props_to_fill) {
             snprintf(buffer, sizeof(buffer), "Step %d/3: Measure %s", _current_step, points[_current_step - 1]);
             props_to_fill->oled_top_props.line1 = buffer;
             props_to_fill->oled_middle_props.progress_bar_props.is_enabled = true;
-            props_to_fill->oled_middle_props.progress_bar_props.label = "Stability";
+            // The dataTask captures the point by itself once the endpoint
+            // predictor is sure of it, so show how long that should take.
+            if (_seconds_to_settle > 0.0) {
+                snprintf(buffer, sizeof(buffer), "Stability ~%.0fs", _seconds_to_settle);
+                props_to_fill->oled_middle_props.progress_bar_props.label = buffer;
+            } else {
+                props_to_fill->oled_middle_props.progress_bar_props.label = "Stability";
+            }
             props_to_fill->oled_middle_props.progress_bar_props.progress_percent = _live_stability_percent;
             // The button is only enabled when the signal is stable
             props_to_fill->button_props.back_text = "Cancel";
-            props_to_fill->button_props.down_text = (_live_stability_percent > 95) ? "Capture" : "Wait...";
+            props_to_fill->button_props.down_text = (_live_stability_percent >= 100) ? "Capture" : "Wait...";
             break;
 
         case WizardState::CALCULATING:
@@ -136,6 +145,7 @@ bool CalibrationWizardScreen::saveWasRequested() { return _save_requested; }
 void CalibrationWizardScreen::clearSaveRequest() { _save_requested = false; }
 
 void CalibrationWizardScreen::setLiveStability(int percent) { _live_stability_percent = percent; }
+void CalibrationWizardScreen::setTimeToSettle(double seconds) { _seconds_to_settle = seconds; }
 
 void CalibrationWizardScreen::setResults(double quality_score, double sensor_drift) {
     _result_quality_score = quality_score;
@@ -147,6 +157,7 @@ void CalibrationWizardScreen::advanceToNextStep() {
     if (_wizard_state == WizardState::MEASURE_POINT) {
         _current_step++;
         _live_stability_percent = 0; // Reset stability for the next point
+        _seconds_to_settle = 0.0;
     }
 }
 
@@ -175,7 +186,7 @@ void CalibrationWizardScreen::handleIntroInput(const InputEvent& event) {
  * @version 3.1.11
  */
 void CalibrationWizardScreen::handleMeasurePointInput(const InputEvent& event) {
-    if (event.type == InputEventType::BTN_DOWN_PRESS && _live_stability_percent > 95) {
+    if (event.type == InputEventType::BTN_DOWN_PRESS && _live_stability_percent >= 100) {
         // --- MODIFIED: Signal the backend instead of changing state directly ---
         _point_capture_requested = true;
     } else if (event.type == InputEventType::BTN_BACK_PRESS) {
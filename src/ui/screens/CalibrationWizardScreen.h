@@ -38,6 +38,8 @@ public:
 
     // Data update methods from the backend
     void setLiveStability(int percent);
+    // --- NEW: Estimated seconds until the reading settles; 0 if unknown ---
+    void setTimeToSettle(double seconds);
     void setResults(double quality_score, double sensor_drift);
 
     // --- NEW: Public methods for the dataTask to control wizard flow ---
@@ -63,6 +65,7 @@ private:
     WizardState _wizard_state;
     int _current_step;
     int _live_stability_percent;
+    double _seconds_to_settle;
 
     // --- NEW: Flag for signaling a point capture to the dataTask ---
     bool _point_capture_requested;
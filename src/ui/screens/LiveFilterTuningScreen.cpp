@@ -23,13 +23,13 @@ LiveFilterTuningScreen::LiveFilterTuningScreen(PBiosContext* context, Calibratio
     _ecCalManager(ecCal),
     _tempManager(tempManager),
     _is_in_manual_tune_mode(false),
+    _snapshot(nullptr),
     _selected_index(0),
     _is_compare_mode_active(false),
     _calibrated_value(NAN)
 {
     for (int i = 0; i < GRAPH_DATA_POINTS; ++i) {
-        _hf_raw_buffer[i] = 0.0; _hf_filtered_buffer[i] = 0.0;
-        _lf_filtered_buffer[i] = 0.0; _ghost_lf_filtered_buffer[i] = 0.0;
+        _ghost_lf_filtered_buffer[i] = 0.0;
     }
 
     _hub_menu_items.push_back("Auto Tune");
@@ -72,25 +72,19 @@ void LiveFilterTuningScreen::getRenderProps(UIRenderProps* props_to_fill) {
 
 void LiveFilterTuningScreen::update() {
     if (!_context || !_context->selectedFilter) return;
-    PI_Filter* hfFilter = _context->selectedFilter->getFilter(0);
-    PI_Filter* lfFilter = _context->selectedFilter->getFilter(1);
-
-    if (hfFilter) {
-        hfFilter->getRawHistory(_hf_raw_buffer, GRAPH_DATA_POINTS);
-        hfFilter->getFilteredHistory(_hf_filtered_buffer, GRAPH_DATA_POINTS);
-        _hf_r_std = hfFilter->getRawStandardDeviation();
-        _hf_f_std = hfFilter->getFilteredStandardDeviation();
-    }
+    // The data task publishes a snapshot after every sample; nothing here
+    // touches the live filters.
+    _snapshot = _context->selectedFilter->getSnapshot();
+    if (!_snapshot) return;
 
-    if (lfFilter) {
-        lfFilter->getFilteredHistory(_lf_filtered_buffer, GRAPH_DATA_POINTS);
-        _lf_r_std = hfFilter ? hfFilter->getFilteredStandardDeviation() : 0.0;
-        _lf_f_std = lfFilter->getFilteredStandardDeviation();
-    }
+    _hf_r_std = _snapshot->hfRawStdDev;
+    _hf_f_std = _snapshot->hfFilteredStdDev;
+    _lf_r_std = _snapshot->hfFilteredStdDev;
+    _lf_f_std = _snapshot->lfFilteredStdDev;
 
     // --- KPI Calculation now uses the new centralized method ---
-    _lf_stab_percent = _context->selectedFilter->getNoiseReductionPercentage();
-    _hf_stab_percent = hfFilter->getStabilityPercentage();
+    _lf_stab_percent = _snapshot->noiseReductionPercent;
+    _hf_stab_percent = _snapshot->hfStabilityPercent;
 
 
     #if DEBUG_DIAGNOSTIC_PIPELINE == 1
@@ -98,8 +92,10 @@ void LiveFilterTuningScreen::update() {
     if (millis() - lastLogTime > 1000) {
         lastLogTime = millis();
         LOG_DIAG("--- pBIOS Filter Report ---");
-        LOG_DIAG("HF Setpoints: Settle=%.3f, Smooth=%.3f", hfFilter->settleThreshold, hfFilter->lockSmoothing);
-        LOG_DIAG("LF Setpoints: Settle=%.3f, Smooth=%.3f", lfFilter->settleThreshold, lfFilter->lockSmoothing);
+        FilterParams hfParams = _context->selectedFilter->getParams(0);
+        FilterParams lfParams = _context->selectedFilter->getParams(1);
+        LOG_DIAG("HF Setpoints: Settle=%.3f, Smooth=%.3f", hfParams.settleThreshold, hfParams.lockSmoothing);
+        LOG_DIAG("LF Setpoints: Settle=%.3f, Smooth=%.3f", lfParams.settleThreshold, lfParams.lockSmoothing);
         LOG_DIAG("Live Stats: Raw_std=%.4f, LF_out_std=%.4f", _hf_r_std, _lf_f_std);
         LOG_DIAG("Final Noise Reduction: %d %%", _lf_stab_percent);
         LOG_DIAG("----------------------------");
@@ -107,10 +103,10 @@ void LiveFilterTuningScreen::update() {
     #endif
 
 
-    if (lfFilter) {
-        double filtered_voltage = lfFilter->getFilteredValue();
+    {
+        double filtered_voltage = _snapshot->filteredValue;
         float temp = _tempManager->getProbeTemp();
-        bool isStable = lfFilter->isLocked();
+        bool isStable = _snapshot->isLocked;
         if (_context->selectedFilter == &phFilter) {
             if (_phCalManager->getCurrentModel().isCalibrated && isStable) {
                 _calibrated_value = _phCalManager->getCompensatedValue(_phCalManager->getCalibratedValue(filtered_voltage), temp, false);
@@ -166,14 +162,15 @@ void LiveFilterTuningScreen::handleHubMenuInput(const InputEvent& event) {
  * @version 3.1.13
  */
 void LiveFilterTuningScreen::getManualTuneRenderProps(UIRenderProps* props_to_fill) {
+    if (!_snapshot) return;
     static char hf_top[40], hf_br[20], lf_top[40], lf_br[20], r_buf[10], f_buf[10];
 
     dtostrf(_hf_r_std, 4, 3, r_buf); dtostrf(_hf_f_std, 4, 3, f_buf);
     snprintf(hf_top, sizeof(hf_top), "R:%s F:%s", r_buf, f_buf);
     snprintf(hf_br, sizeof(hf_br), "Stab:%d%%", _hf_stab_percent);
     props_to_fill->oled_top_props.graph_props.is_enabled = true;
-    props_to_fill->oled_top_props.graph_props.pre_filter_data = _hf_raw_buffer;
-    props_to_fill->oled_top_props.graph_props.post_filter_data = _hf_filtered_buffer;
+    props_to_fill->oled_top_props.graph_props.pre_filter_data = _snapshot->hfRaw;
+    props_to_fill->oled_top_props.graph_props.post_filter_data = _snapshot->hfFiltered;
     props_to_fill->oled_top_props.graph_props.top_left_label = hf_top;
     props_to_fill->oled_top_props.graph_props.bottom_left_label = "HF";
     props_to_fill->oled_top_props.graph_props.bottom_right_label = hf_br;
@@ -195,17 +192,17 @@ void LiveFilterTuningScreen::getManualTuneRenderProps(UIRenderProps* props_to_fi
     // --- DEFINITIVE FIX: Change the label to reflect the new KPI ---
     snprintf(lf_br, sizeof(lf_br), "NR:%d%%", _lf_stab_percent);
     props_to_fill->oled_bottom_props.graph_props.is_enabled = true;
-    props_to_fill->oled_bottom_props.graph_props.pre_filter_data = _hf_filtered_buffer;
-    props_to_fill->oled_bottom_props.graph_props.post_filter_data = _lf_filtered_buffer;
+    props_to_fill->oled_bottom_props.graph_props.pre_filter_data = _snapshot->hfFiltered;
+    props_to_fill->oled_bottom_props.graph_props.post_filter_data = _snapshot->lfFiltered;
     props_to_fill->oled_bottom_props.graph_props.top_left_label = lf_top;
     props_to_fill->oled_bottom_props.graph_props.bottom_left_label = "LF";
     props_to_fill->oled_bottom_props.graph_props.bottom_right_label = lf_br;
 
-    double min_y = _hf_raw_buffer[0];
-    double max_y = _hf_raw_buffer[0];
+    double min_y = _snapshot->hfRaw[0];
+    double max_y = _snapshot->hfRaw[0];
     for(int i = 1; i < GRAPH_DATA_POINTS; ++i) {
-        min_y = std::min(min_y, _hf_raw_buffer[i]);
-        max_y = std::max(max_y, _hf_raw_buffer[i]);
+        min_y = std::min(min_y, _snapshot->hfRaw[i]);
+        max_y = std::max(max_y, _snapshot->hfRaw[i]);
     }
 
     double padding = (max_y - min_y) * 0.1;
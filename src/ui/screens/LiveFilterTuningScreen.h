@@ -47,9 +47,8 @@ private:
 
     // Local state and data buffers
     bool _is_in_manual_tune_mode;
-    double _hf_raw_buffer[GRAPH_DATA_POINTS];
-    double _hf_filtered_buffer[GRAPH_DATA_POINTS];
-    double _lf_filtered_buffer[GRAPH_DATA_POINTS];
+    // Latest snapshot published by the data task; read in place, never copied.
+    const FilterSnapshot* _snapshot;
     double _ghost_lf_filtered_buffer[GRAPH_DATA_POINTS];
     bool _is_compare_mode_active;
     double _hf_f_std, _hf_r_std, _lf_f_std, _lf_r_std;
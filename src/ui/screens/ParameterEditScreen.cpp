@@ -28,8 +28,8 @@ void ParameterEditScreen::onEnter(StateManager* stateManager, int context) {
     _is_editing = false;
     _selected_index = 0;
     if (_context && _context->selectedFilter) {
-        _hf_snapshot = *_context->selectedFilter->getFilter(0);
-        _lf_snapshot = *_context->selectedFilter->getFilter(1);
+        _hf_snapshot = _context->selectedFilter->getParams(0);
+        _lf_snapshot = _context->selectedFilter->getParams(1);
     }
 }
 
@@ -39,8 +39,7 @@ void ParameterEditScreen::handleInput(const InputEvent& event) {
             _is_editing = false;
         } else {
             if (_context && _context->selectedFilter) {
-                *_context->selectedFilter->getFilter(0) = _hf_snapshot;
-                *_context->selectedFilter->getFilter(1) = _lf_snapshot;
+                _context->selectedFilter->publishParams(_hf_snapshot, _lf_snapshot);
             }
             if (_stateManager) _stateManager->changeState(ScreenState::LIVE_FILTER_TUNING);
         }
@@ -56,17 +55,22 @@ void ParameterEditScreen::handleInput(const InputEvent& event) {
     }
 
     if (_is_editing) {
-        PI_Filter* filter = (_selected_index < 4) ? _context->selectedFilter->getFilter(0) : _context->selectedFilter->getFilter(1);
-        if (!filter) return;
+        if (!_context || !_context->selectedFilter) return;
+        // Edit a copy and publish it; the data task picks it up at the next sample.
+        int stage = (_selected_index < 4) ? 0 : 1;
+        // --- NEW: Behind a Hampel stage there is no HF PI stage to edit. ---
+        if (!_context->selectedFilter->hasPIStage(stage)) return;
+        FilterParams params = _context->selectedFilter->getParams(stage);
         int local_param_index = _selected_index % 4;
         double step = (local_param_index == 3) ? 0.001 * event.value : 0.01 * event.value;
         double change = (event.type == InputEventType::ENCODER_INCREMENT) ? step : -step;
         switch (local_param_index) {
-            case 0: filter->settleThreshold += change; break;
-            case 1: filter->lockSmoothing += change; break;
-            case 2: filter->trackResponse += change; break;
-            case 3: filter->trackAssist += change; break;
+            case 0: params.settleThreshold += change; break;
+            case 1: params.lockSmoothing += change; break;
+            case 2: params.trackResponse += change; break;
+            case 3: params.trackAssist += change; break;
         }
+        _context->selectedFilter->publishParams(stage, params);
     } else {
         if (event.type == InputEventType::ENCODER_INCREMENT) { if (_selected_index < _param_menu_items.size() - 1) _selected_index++; }
         else if (event.type == InputEventType::ENCODER_DECREMENT) { if (_selected_index > 0) _selected_index--; }
@@ -79,6 +83,8 @@ void ParameterEditScreen::getRenderProps(UIRenderProps* props_to_fill) {
     LiveFilterTuningScreen* workbench = static_cast<LiveFilterTuningScreen*>(_stateManager->getScreen(ScreenState::LIVE_FILTER_TUNING));
     if (!workbench) return;
 
+    // Refresh the workbench's snapshot so the graphs stay live while editing.
+    workbench->update();
     workbench->getManualTuneRenderProps(props_to_fill);
 
     OledProps& mid_props = props_to_fill->oled_middle_props;
@@ -97,16 +103,17 @@ void ParameterEditScreen::getRenderProps(UIRenderProps* props_to_fill) {
 
 std::string ParameterEditScreen::getSelectedParamValueString() {
     if (!_context || !_context->selectedFilter) return "N/A";
-    PI_Filter* filter = (_selected_index < 4) ? _context->selectedFilter->getFilter(0) : _context->selectedFilter->getFilter(1);
-    if (!filter) return "N/A";
+    int stage = (_selected_index < 4) ? 0 : 1;
+    if (!_context->selectedFilter->hasPIStage(stage)) return "Value: Hampel";
+    FilterParams params = _context->selectedFilter->getParams(stage);
     int param_index = _selected_index % 4;
     char buffer[20];
     double val = 0.0;
     switch (param_index) {
-        case 0: val = filter->settleThreshold; dtostrf(val, 4, 3, buffer); break;
-        case 1: val = filter->lockSmoothing; dtostrf(val, 4, 3, buffer); break;
-        case 2: val = filter->trackResponse; dtostrf(val, 4, 3, buffer); break;
-        case 3: val = filter->trackAssist; dtostrf(val, 4, 4, buffer); break;
+        case 0: val = params.settleThreshold; dtostrf(val, 4, 3, buffer); break;
+        case 1: val = params.lockSmoothing; dtostrf(val, 4, 3, buffer); break;
+        case 2: val = params.trackResponse; dtostrf(val, 4, 3, buffer); break;
+        case 3: val = params.trackAssist; dtostrf(val, 4, 4, buffer); break;
     }
     return std::string("Value: ") + buffer;
 }
\ No newline at end of file
@@ -23,8 +23,8 @@ private:
     int _selected_index;
     bool _is_editing;
     
-    PI_Filter _hf_snapshot;
-    PI_Filter _lf_snapshot;
+    FilterParams _hf_snapshot;
+    FilterParams _lf_snapshot;
     
     std::vector<std::string> _param_menu_items;
 };
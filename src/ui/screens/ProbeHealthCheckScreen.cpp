@@ -9,7 +9,8 @@ ProbeHealthCheckScreen::ProbeHealthCheckScreen() :
     _state(HealthCheckState::SELECT_PROBE),
     _selected_index(0),
     _live_stability_percent(0),
-    _health_result_percent(0.0)
+    _health_result_percent(0.0),
+    _check_requested(false)
 {
     _menu_items.push_back("pH Probe");
     _menu_items.push_back("EC Probe");
@@ -18,6 +19,8 @@ ProbeHealthCheckScreen::ProbeHealthCheckScreen() :
 void ProbeHealthCheckScreen::onEnter(StateManager* stateManager, int context) {
     Screen::onEnter(stateManager);
     _state = HealthCheckState::SELECT_PROBE;
+    _live_stability_percent = 0;
+    _check_requested = false;
 }
 
 void ProbeHealthCheckScreen::handleInput(const InputEvent& event) {
@@ -27,12 +30,19 @@ void ProbeHealthCheckScreen::handleInput(const InputEvent& event) {
         } else if (event.type == InputEventType::ENCODER_DECREMENT) {
             if (_selected_index > 0) _selected_index--;
         } else if (event.type == InputEventType::BTN_ENTER_PRESS) {
+            _live_stability_percent = 0;
             _state = HealthCheckState::MEASURING;
         } else if (event.type == InputEventType::BTN_BACK_PRESS) {
             if (_stateManager) _stateManager->changeState(ScreenState::CALIBRATION_MENU);
         }
     } else if (_state == HealthCheckState::MEASURING) {
-        // STUB: Add logic for capturing when stable
+        // The dataTask captures on its own once the reading is flat; the
+        // button only forces it while the reading is stable.
+        if (event.type == InputEventType::BTN_DOWN_PRESS && _live_stability_percent >= 100) {
+            _check_requested = true;
+        } else if (event.type == InputEventType::BTN_BACK_PRESS) {
+            _state = HealthCheckState::SELECT_PROBE;
+        }
     } else if (_state == HealthCheckState::VIEW_RESULT) {
         if (event.type == InputEventType::BTN_BACK_PRESS || event.type == InputEventType::BTN_ENTER_PRESS) {
              if (_stateManager) _stateManager->changeState(ScreenState::CALIBRATION_MENU);
@@ -40,6 +50,12 @@ void ProbeHealthCheckScreen::handleInput(const InputEvent& event) {
     }
 }
 
+void ProbeHealthCheckScreen::setResult(double health_percent) {
+    _health_result_percent = health_percent;
+    _check_requested = false;
+    _state = HealthCheckState::VIEW_RESULT;
+}
+
 void ProbeHealthCheckScreen::getRenderProps(UIRenderProps* props_to_fill) {
     *props_to_fill = UIRenderProps();
     char buffer[40];
@@ -59,7 +75,8 @@ void ProbeHealthCheckScreen::getRenderProps(UIRenderProps* props_to_fill) {
         props_to_fill->oled_middle_props.progress_bar_props.is_enabled = true;
         props_to_fill->oled_middle_props.progress_bar_props.label = "Stability";
         props_to_fill->oled_middle_props.progress_bar_props.progress_percent = _live_stability_percent;
-        props_to_fill->button_props.down_text = (_live_stability_percent > 95) ? "Check Health" : "Wait...";
+        props_to_fill->button_props.down_text = (_live_stability_percent >= 100) ? "Check Health" : "Wait...";
+        props_to_fill->button_props.back_text = "Back";
     } else if (_state == HealthCheckState::VIEW_RESULT) {
         props_to_fill->oled_top_props.line1 = "Health Check Result";
         snprintf(buffer, sizeof(buffer), "%s Health:", _menu_items[_selected_index].c_str());
@@ -5,9 +5,16 @@
 #define PROBE_HEALTH_CHECK_SCREEN_H
 
 #include "ui/StateManager.h"
+#include "ProbeMeasurementScreen.h" // For ProbeType enum
 #include <vector>
 #include <string>
 
+// The buffers the check is made in, in calibrated units (pH, mS/cm).
+#define HEALTH_CHECK_PH_REFERENCE 6.86
+#define HEALTH_CHECK_EC_REFERENCE 1.413
+// A reading this far from the reference, as a fraction of it, scores 0%.
+#define HEALTH_CHECK_ZERO_HEALTH_ERROR 0.1
+
 /**
  * @class ProbeHealthCheckScreen
  * @brief A screen for performing a quick 1-point probe health check.
@@ -19,6 +26,18 @@ public:
     void handleInput(const InputEvent& event) override;
     void getRenderProps(UIRenderProps* props_to_fill) override;
 
+    // --- NEW: Public methods for the dataTask to run the check ---
+    ProbeType getProbeType() const { return (_selected_index == 0) ? ProbeType::PH : ProbeType::EC; }
+    bool isMeasuring() const { return _state == HealthCheckState::MEASURING; }
+
+    // Request/clear methods for a manual capture
+    bool checkWasRequested() { return _check_requested; }
+    void clearCheckRequest() { _check_requested = false; }
+
+    // Data update methods from the backend
+    void setLiveStability(int percent) { _live_stability_percent = percent; }
+    void setResult(double health_percent);
+
 private:
     enum class HealthCheckState {
         SELECT_PROBE,
@@ -31,6 +50,7 @@ private:
     int _selected_index;
     int _live_stability_percent;
     double _health_result_percent;
+    bool _check_requested;
 };
 
 #endif // PROBE_HEALTH_CHECK_SCREEN_H
\ No newline at end of file
@@ -16,17 +16,24 @@ extern TempManager tempManager;
 ProbeMeasurementScreen::ProbeMeasurementScreen() :
     _probe_type(ProbeType::PH),
     _capture_requested(false),
+    _accept_requested(false),
     _calibrated_value(NAN),
     _temperature(NAN),
     _stability_percent(0),
     _raw_millivolts(0.0),
-    _filtered_millivolts(0.0)
+    _filtered_millivolts(0.0),
+    _prediction_ready(false),
+    _predicted_value(NAN),
+    _seconds_to_settle(0.0)
 {}
 
 void ProbeMeasurementScreen::onEnter(StateManager* stateManager, int probe_type_int) {
     Screen::onEnter(stateManager);
     _probe_type = static_cast<ProbeType>(probe_type_int);
     _capture_requested = false;
+    _accept_requested = false;
+    _prediction_ready = false;
+    _seconds_to_settle = 0.0;
 
     uint8_t probe_index = (_probe_type == ProbeType::PH) ? 0 : 1;
     adcManager.setProbeState(probe_index, ProbeState::ACTIVE);
@@ -42,6 +49,9 @@ void ProbeMeasurementScreen::handleInput(const InputEvent& event) {
         if (_stateManager) _stateManager->changeState(ScreenState::MEASURE_MENU);
     } else if (event.type == InputEventType::BTN_DOWN_PRESS) {
         _capture_requested = true;
+    } else if (event.type == InputEventType::BTN_ENTER_PRESS && _prediction_ready && _seconds_to_settle > 0.0) {
+        _capture_requested = true;
+        _accept_requested = true;
     }
 }
 
@@ -65,7 +75,14 @@ void ProbeMeasurementScreen::getRenderProps(UIRenderProps* props_to_fill) {
     props_to_fill->oled_top_props.line2 = buffer;
     snprintf(buffer, sizeof(buffer), "Temp: %.1f C", _temperature);
     props_to_fill->oled_top_props.line3 = buffer;
-    snprintf(buffer, sizeof(buffer), "Stab: %d%%", _stability_percent);
+    // While the reading is still settling, show where it is heading.
+    if (_prediction_ready && _seconds_to_settle > 0.0) {
+        snprintf(buffer, sizeof(buffer), "Pred: %.2f ~%.0fs", _predicted_value, _seconds_to_settle);
+    } else if (_seconds_to_settle > 0.0) {
+        snprintf(buffer, sizeof(buffer), "Stab: %d%% ~%.0fs", _stability_percent, _seconds_to_settle);
+    } else {
+        snprintf(buffer, sizeof(buffer), "Stab: %d%%", _stability_percent);
+    }
     props_to_fill->oled_top_props.line4 = buffer;
 
 
@@ -90,6 +107,9 @@ void ProbeMeasurementScreen::getRenderProps(UIRenderProps* props_to_fill) {
     // --- Button Prompts ---
     props_to_fill->button_props.back_text = "Back";
     props_to_fill->button_props.down_text = "Capture";
+    if (_prediction_ready && _seconds_to_settle > 0.0) {
+        props_to_fill->button_props.enter_text = "Accept";
+    }
 }
 
 
@@ -101,10 +121,17 @@ void ProbeMeasurementScreen::updateData(double calibrated_value, double temp, in
     _filtered_millivolts = filtered_mv;
 }
 
+void ProbeMeasurementScreen::setPrediction(bool ready, double predicted_value, double seconds_to_settle) {
+    _prediction_ready = ready;
+    _predicted_value = predicted_value;
+    _seconds_to_settle = seconds_to_settle;
+}
+
 bool ProbeMeasurementScreen::captureWasRequested() {
     return _capture_requested;
 }
 
 void ProbeMeasurementScreen::clearCaptureRequest() {
     _capture_requested = false;
+    _accept_requested = false;
 }
\ No newline at end of file
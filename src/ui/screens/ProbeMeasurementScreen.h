@@ -7,6 +7,10 @@
 #include "ui/StateManager.h"
 #include "ui/blocks/CalibrationCurveBlock.h" // For props struct
 
+// How precisely, in mV, a predicted endpoint must be known before the
+// screens offer it. 1 mV is about 0.017 pH.
+#define ENDPOINT_TOLERANCE_MV 1.0
+
 /**
  * @enum ProbeType
  * @brief Defines the type of probe being measured.
@@ -38,14 +42,25 @@ public:
     // Public method for the dataTask to know which probe is active
     ProbeType getActiveProbeType() const { return _probe_type; }
 
+    /**
+     * @brief --- NEW: Where the reading is heading, from the endpoint predictor. ---
+     * @param ready True once the predicted value can be accepted.
+     * @param predicted_value The predicted final reading, in display units.
+     * @param seconds_to_settle Until the live reading gets there; 0 if unknown.
+     */
+    void setPrediction(bool ready, double predicted_value, double seconds_to_settle);
+
     // Public method for handling the capture request
     bool captureWasRequested();
+    // --- NEW: A capture of the predicted reading rather than the live one ---
+    bool acceptWasRequested() const { return _accept_requested; }
     void clearCaptureRequest();
 
 
 private:
     ProbeType _probe_type;
     bool _capture_requested;
+    bool _accept_requested;
 
     // --- Data to be displayed ---
     double _calibrated_value;
@@ -53,6 +68,9 @@ private:
     int _stability_percent;
     double _raw_millivolts;
     double _filtered_millivolts;
+    bool _prediction_ready;
+    double _predicted_value;
+    double _seconds_to_settle;
 };
 
 #endif // PROBE_MEASUREMENT_SCREEN_H
\ No newline at end of file
@@ -107,10 +107,10 @@ const std::string& ProbeProfilingScreen::getSelectedFilterName() const {
     return (_selected_index == 0) ? ph_name : ec_name;
 }
 
-void ProbeProfilingScreen::setAnalysisResults(double live_r_std, const PI_Filter& hfFilter, const PI_Filter& lfFilter, double zero_point_drift, double cal_quality_score, const std::string& last_cal_timestamp) {
+void ProbeProfilingScreen::setAnalysisResults(double live_r_std, const FilterParams& hfParams, const FilterParams& lfParams, double zero_point_drift, double cal_quality_score, const std::string& last_cal_timestamp) {
     _live_r_std = live_r_std;
-    _hf_params_snapshot = hfFilter;
-    _lf_params_snapshot = lfFilter;
+    _hf_params_snapshot = hfParams;
+    _lf_params_snapshot = lfParams;
     _zero_point_drift = zero_point_drift;
     _cal_quality_score = cal_quality_score;
     _last_cal_timestamp = last_cal_timestamp;
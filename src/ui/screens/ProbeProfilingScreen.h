@@ -7,7 +7,9 @@
 #include "ui/StateManager.h"
 #include <vector>
 #include <string>
-#include "FilterManager.h" // Needed for PI_Filter definition
+#include "FilterManager.h" // Needed for FilterParams definition
+
+#define PROFILING_SAMPLE_COUNT 50
 
 /**
  * @class ProbeProfilingScreen
@@ -25,7 +27,7 @@ public:
     uint8_t getSelectedAdcIndex() const;
     uint8_t getSelectedAdcInput() const;
     const std::string& getSelectedFilterName() const;
-    void setAnalysisResults(double live_r_std, const PI_Filter& hfFilter, const PI_Filter& lfFilter, double zero_point_drift, double cal_quality_score, const std::string& last_cal_timestamp);
+    void setAnalysisResults(double live_r_std, const FilterParams& hfParams, const FilterParams& lfParams, double zero_point_drift, double cal_quality_score, const std::string& last_cal_timestamp);
 
     // --- NEW: Public method to update the progress bar ---
     void setProgress(int percent);
@@ -49,8 +51,8 @@ private:
 
     // --- Data for the report card ---
     double _live_r_std;
-    PI_Filter _hf_params_snapshot;
-    PI_Filter _lf_params_snapshot;
+    FilterParams _hf_params_snapshot;
+    FilterParams _lf_params_snapshot;
     double _zero_point_drift;
     double _cal_quality_score;
     std::string _last_cal_timestamp;
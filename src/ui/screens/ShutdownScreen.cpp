@@ -5,9 +5,11 @@
 #include "ui/UIManager.h"
 #include "ConfigManager.h"
 #include "SdManager.h"
+#include "RtcManager.h"
 
 extern ConfigManager configManager;
 extern SdManager sdManager;
+extern RtcManager rtcManager;
 extern FilterManager phFilter, ecFilter, v3_3_Filter, v5_0_Filter;
 extern char g_sessionTimestamp[20];
 
@@ -31,6 +33,9 @@ void ShutdownScreen::handleInput(const InputEvent& event) {
                 configManager.saveFilterSettings(ecFilter, "ec_filter", "default");
                 configManager.saveFilterSettings(v3_3_Filter, "v3_3_filter", "default");
                 configManager.saveFilterSettings(v5_0_Filter, "v5_0_filter", "default");
+                // Runtime state too, so the next measurement can warm-start.
+                configManager.saveFilterState(phFilter, "ph_filter", rtcManager.getUnixTime());
+                configManager.saveFilterState(ecFilter, "ec_filter", rtcManager.getUnixTime());
                 break;
 
             case 1: // Discard & Shutdown
@@ -41,6 +46,8 @@ void ShutdownScreen::handleInput(const InputEvent& event) {
                 sdManager.remove("/config/ec_filter.json");
                 sdManager.remove("/config/v3_3_filter.json");
                 sdManager.remove("/config/v5_0_filter.json");
+                sdManager.remove("/config/ph_filter_state.bin");
+                sdManager.remove("/config/ec_filter_state.bin");
                 break;
         }
         if (_stateManager) _stateManager->changeState(ScreenState::POWER_OFF);
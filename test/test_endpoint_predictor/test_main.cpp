@@ -0,0 +1,112 @@
+// File Path: /test/test_endpoint_predictor/test_main.cpp
+
+#include <Arduino.h>
+#include <unity.h>
+#include <EndpointPredictor.h>
+#include <cmath>
+
+#define SAMPLE_PERIOD_S 0.022
+#define TOLERANCE_MV 1.0
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+// A glass electrode moving from 0 to 'endpoint' mV, with +/-0.5 mV of noise.
+static double electrode(double t, double endpoint, double tau) {
+    return endpoint * (1.0 - std::exp(-t / tau)) + random(-100, 100) / 200.0;
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: The endpoint of an exponential approach is known to
+ * within the tolerance well before the signal itself gets there.
+ */
+void test_endpoint_predicts_before_settling() {
+    // ARRANGE: The time constant of a sluggish electrode.
+    const double endpoint = 177.0, tau = 20.0;
+    EndpointPredictor predictor(SAMPLE_PERIOD_S, TOLERANCE_MV);
+    randomSeed(11);
+    // The signal is within the tolerance after tau * ln(177 / 1), about 104 s.
+    double settledAt = tau * std::log(endpoint / TOLERANCE_MV);
+    double readyAt = -1.0;
+
+    // ACT
+    for (int i = 0; i < 10000 && readyAt < 0.0; ++i) {
+        double t = i * SAMPLE_PERIOD_S;
+        predictor.push(electrode(t, endpoint, tau));
+        if (predictor.isReady()) readyAt = t;
+    }
+
+    // ASSERT
+    const EndpointEstimate& estimate = predictor.getEstimate();
+    TEST_ASSERT_TRUE(readyAt > 0.0);
+    TEST_ASSERT_TRUE(readyAt < 0.75 * settledAt);
+    TEST_ASSERT_TRUE(estimate.valid);
+    TEST_ASSERT_FALSE(estimate.settled);
+    TEST_ASSERT_DOUBLE_WITHIN(TOLERANCE_MV, endpoint, estimate.value);
+    TEST_ASSERT_TRUE(estimate.band <= TOLERANCE_MV);
+    TEST_ASSERT_DOUBLE_WITHIN(0.25 * tau, tau, estimate.timeConstant);
+    TEST_ASSERT_DOUBLE_WITHIN(15.0, settledAt - readyAt, estimate.timeToSettle);
+    TEST_ASSERT_TRUE(predictor.sawApproach());
+}
+
+/**
+ * @brief Test Case 2: A probe that is already settled is reported as such,
+ * and is not mistaken for one that has just arrived.
+ */
+void test_endpoint_settled_signal() {
+    // ARRANGE
+    EndpointPredictor predictor(SAMPLE_PERIOD_S, TOLERANCE_MV);
+    randomSeed(3);
+
+    // ACT: 10 seconds at 100 mV.
+    for (int i = 0; i < 455; ++i) predictor.push(100.0 + random(-100, 100) / 200.0);
+
+    // ASSERT
+    const EndpointEstimate& estimate = predictor.getEstimate();
+    TEST_ASSERT_TRUE(predictor.isReady());
+    TEST_ASSERT_TRUE(estimate.settled);
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, estimate.timeToSettle);
+    TEST_ASSERT_DOUBLE_WITHIN(0.2, 100.0, estimate.value);
+    TEST_ASSERT_FALSE(predictor.sawApproach());
+}
+
+/**
+ * @brief Test Case 3: Steady drift has no endpoint and is not extrapolated.
+ */
+void test_endpoint_ignores_drift() {
+    // ARRANGE
+    EndpointPredictor predictor(SAMPLE_PERIOD_S, TOLERANCE_MV);
+    randomSeed(5);
+
+    // ACT: 4 minutes of drift at 2 mV/min, with NaN readings mixed in.
+    for (int i = 0; i < 11000; ++i) {
+        double t = i * SAMPLE_PERIOD_S;
+        predictor.push((i % 97 == 0) ? NAN : 100.0 + t / 30.0 + random(-100, 100) / 200.0);
+    }
+
+    // ASSERT
+    TEST_ASSERT_FALSE(predictor.getEstimate().valid);
+    TEST_ASSERT_FALSE(predictor.isReady());
+
+    // ACT: Start over.
+    predictor.reset();
+
+    // ASSERT
+    TEST_ASSERT_FALSE(predictor.getEstimate().valid);
+    TEST_ASSERT_FALSE(predictor.sawApproach());
+}
+
+// --- TEST RUNNER ---
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+    RUN_TEST(test_endpoint_predicts_before_settling);
+    RUN_TEST(test_endpoint_settled_signal);
+    RUN_TEST(test_endpoint_ignores_drift);
+    UNITY_END();
+}
+
+void loop() {}
@@ -4,7 +4,10 @@
 #include <unity.h>
 #include <FilterManager.h>
 #include <ConfigManager.h>
+#include <TuningRefinement.h>
 #include <FaultHandler.h>
+#include <algorithm>
+#include <cmath>
 
 // --- Global Test Objects & Mocks ---
 FaultHandler testFaultHandler;
@@ -23,9 +26,10 @@ void test_filter_manager_initialization() {
     // ARRANGE
     FilterManager filterManager;
     // ACT
-    bool success = filterManager.begin(testFaultHandler, testConfigManager);
-    // ASSERT
+    bool success = filterManager.begin(testFaultHandler, "test_filter");
+    // ASSERT: HF, the LF decimator when it is on, and LF.
     TEST_ASSERT_TRUE(success);
+    TEST_ASSERT_EQUAL(FILTER_LF_DECIMATION > 1 ? 3 : 2, filterManager.getStageCount());
 }
 
 /**
@@ -34,7 +38,11 @@ void test_filter_manager_initialization() {
 void test_filter_manager_pipeline() {
     // ARRANGE: Create and initialize a FilterManager instance.
     FilterManager filterManager;
-    filterManager.begin(testFaultHandler, testConfigManager);
+    filterManager.begin(testFaultHandler, "test_filter");
+    // LF at the full rate, so the arithmetic below holds. The new pipeline
+    // is built at the next sample boundary.
+    filterManager.configure(FilterPipelineConfig::standard(filterManager.getParams(0), filterManager.getParams(1)));
+    filterManager.process(100.0);
 
     PI_Filter* hfFilter = filterManager.getFilter(0);
     PI_Filter* lfFilter = filterManager.getFilter(1);
@@ -45,15 +53,15 @@ void test_filter_manager_pipeline() {
     // The default median filter window (size 5) was rejecting the new value
     // as a spike. By setting the window size to 1, the median filter becomes
     // transparent, allowing us to test the PI smoothing pipeline directly.
-    hfFilter->medianWindowSize = 1;
-    lfFilter->medianWindowSize = 1;
+    hfFilter->params.medianWindowSize = 1;
+    lfFilter->params.medianWindowSize = 1;
 
     // ARRANGE: Configure the filters with simple, predictable behavior.
-    hfFilter->lockSmoothing = 0.5;
-    hfFilter->settleThreshold = 1000; // Force into LOCKED state
+    hfFilter->params.lockSmoothing = 0.5;
+    hfFilter->params.settleThreshold = 1000; // Force into LOCKED state
 
-    lfFilter->lockSmoothing = 0.5;
-    lfFilter->settleThreshold = 1000; // Force into LOCKED state
+    lfFilter->params.lockSmoothing = 0.5;
+    lfFilter->params.settleThreshold = 1000; // Force into LOCKED state
 
     // ARRANGE: Prime the filters by running them 50 times to ensure their
     // internal state converges to a stable 100.0.
@@ -75,6 +83,506 @@ void test_filter_manager_pipeline() {
     TEST_ASSERT_FLOAT_WITHIN(0.01, expectedValue, finalValue);
 }
 
+/**
+ * @brief Test Case 3: Batch processing matches per-sample processing.
+ */
+void test_filter_manager_batch_matches_single() {
+    // ARRANGE: Two identical managers fed the same noisy, spiky signal.
+    FilterManager single;
+    FilterManager batch;
+    single.begin(testFaultHandler, "test_single");
+    batch.begin(testFaultHandler, "test_batch");
+
+    const size_t count = 100; // Not a multiple of the internal block size
+    sample_t input[count];
+    sample_t expected[count];
+    randomSeed(11);
+    for (size_t i = 0; i < count; ++i) {
+        input[i] = 1500.0 + random(-100, 100) / 10.0;
+        if (i % 17 == 0) input[i] += 80.0;
+    }
+
+    // ACT
+    for (size_t i = 0; i < count; ++i) expected[i] = single.process(input[i]);
+    sample_t output[count];
+    batch.process(input, output, count);
+
+    // ASSERT: Same outputs and the same KPIs at the end of the block.
+    for (size_t i = 0; i < count; ++i) {
+        TEST_ASSERT_EQUAL_DOUBLE(expected[i], output[i]);
+    }
+    for (int stage = 0; stage < 2; ++stage) {
+        TEST_ASSERT_EQUAL_DOUBLE(single.getFilter(stage)->getRawStandardDeviation(),
+                                 batch.getFilter(stage)->getRawStandardDeviation());
+        TEST_ASSERT_EQUAL(single.getFilter(stage)->getStabilityPercentage(),
+                          batch.getFilter(stage)->getStabilityPercentage());
+    }
+}
+
+/**
+ * @brief Test Case 4: Published setpoints take effect at the next sample.
+ */
+void test_filter_manager_publish_params() {
+    // ARRANGE
+    FilterManager filterManager;
+    filterManager.begin(testFaultHandler, "test_publish");
+    filterManager.configure(FilterPipelineConfig::standard(filterManager.getParams(0), filterManager.getParams(1)));
+    FilterParams hfParams = filterManager.getParams(0);
+    hfParams.settleThreshold = 2.5;
+    hfParams.medianWindowSize = 7;
+
+    // ACT: Publish while the "data task" is between samples.
+    filterManager.publishParams(0, hfParams);
+
+    // ASSERT: Readers see the new set at once; the live filter does not yet.
+    TEST_ASSERT_TRUE(filterManager.getParams(0) == hfParams);
+    TEST_ASSERT_EQUAL_DOUBLE((sample_t)0.1, filterManager.getFilter(0)->params.settleThreshold);
+
+    // ACT: The next sample boundary applies it.
+    filterManager.process(1.0);
+
+    // ASSERT: HF is updated and LF is untouched.
+    TEST_ASSERT_TRUE(filterManager.getFilter(0)->params == hfParams);
+    TEST_ASSERT_EQUAL(15, filterManager.getFilter(1)->params.medianWindowSize);
+}
+
+/**
+ * @brief Test Case 5: Snapshots are immutable once handed to the reader.
+ */
+void test_filter_manager_snapshot() {
+    // ARRANGE
+    FilterManager filterManager;
+    filterManager.begin(testFaultHandler, "test_snapshot");
+    TEST_ASSERT_NULL(filterManager.getSnapshot());
+    for (int i = 0; i < 10; ++i) filterManager.process(100.0);
+
+    // ACT
+    filterManager.publishSnapshot();
+    const FilterSnapshot* first = filterManager.getSnapshot();
+
+    // ASSERT: The snapshot matches the filters at the time of publishing.
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_EQUAL(1, first->sequence);
+    TEST_ASSERT_EQUAL_DOUBLE(100.0, first->hfRaw[FILTER_HISTORY_SIZE - 1]);
+    TEST_ASSERT_EQUAL_DOUBLE(filterManager.getFilter(1)->getFilteredValue(), first->filteredValue);
+
+    // ACT: The data task moves on and publishes twice more.
+    filterManager.process(200.0);
+    filterManager.publishSnapshot();
+    filterManager.process(300.0);
+    filterManager.publishSnapshot();
+
+    // ASSERT: The held snapshot is untouched until the reader asks again.
+    TEST_ASSERT_EQUAL(1, first->sequence);
+    TEST_ASSERT_EQUAL_DOUBLE(100.0, first->hfRaw[FILTER_HISTORY_SIZE - 1]);
+    const FilterSnapshot* latest = filterManager.getSnapshot();
+    TEST_ASSERT_EQUAL(3, latest->sequence);
+    TEST_ASSERT_EQUAL_DOUBLE(300.0, latest->hfRaw[FILTER_HISTORY_SIZE - 1]);
+}
+
+/**
+ * @brief Test Case 6: A one-stage moving-average pipeline replaces HF/LF.
+ */
+void test_filter_manager_configure_pipeline() {
+    // ARRANGE
+    FilterManager filterManager;
+    filterManager.begin(testFaultHandler, "test_rail");
+    FilterPipelineConfig config;
+    FilterStageConfig average;
+    average.type = FilterStageType::MOVING_AVERAGE;
+    average.size = 4;
+    config.add(average);
+
+    // ACT: The new pipeline is built at the next sample boundary.
+    TEST_ASSERT_TRUE(filterManager.configure(config));
+    sample_t outputs[6];
+    const sample_t inputs[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    for (int i = 0; i < 6; ++i) outputs[i] = filterManager.process(inputs[i]);
+
+    // ASSERT: No PI stages remain, and the output is the running average.
+    TEST_ASSERT_EQUAL(1, filterManager.getStageCount());
+    TEST_ASSERT_NULL(filterManager.getFilter(0));
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, outputs[0]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.5, outputs[3]);
+    TEST_ASSERT_EQUAL_DOUBLE(4.5, outputs[5]);
+}
+
+/**
+ * @brief Test Case 7: Stages after a decimator only see every Nth sample.
+ */
+void test_filter_manager_decimated_pipeline() {
+    // ARRANGE: Decimate by 3, then a transparent PI stage.
+    FilterManager filterManager;
+    filterManager.begin(testFaultHandler, "test_decimated");
+    FilterPipelineConfig config;
+    FilterStageConfig decimator;
+    decimator.type = FilterStageType::DECIMATOR;
+    decimator.size = 3;
+    config.add(decimator);
+    FilterStageConfig pi;
+    pi.params.medianWindowSize = 1;
+    pi.params.settleThreshold = 1000; // Always LOCKED
+    pi.params.lockSmoothing = 1.0;    // Output follows input
+    config.add(pi);
+    filterManager.configure(config);
+
+    // ACT
+    sample_t outputs[6];
+    for (int i = 0; i < 6; ++i) outputs[i] = filterManager.process((sample_t)(i + 1));
+
+    // ASSERT: Outputs change only on every third sample and hold in between.
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, outputs[2]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, outputs[3]);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, outputs[4]);
+    TEST_ASSERT_EQUAL_DOUBLE(5.0, outputs[5]);
+    TEST_ASSERT_NOT_NULL(filterManager.getFilter(0));
+    TEST_ASSERT_EQUAL_DOUBLE(5.0, filterManager.getFilter(0)->getFilteredValue());
+}
+
+/**
+ * @brief Test Case 8: A decimated LF stage tracks the full-rate pipeline.
+ */
+void test_filter_manager_multirate_matches_standard() {
+    // ARRANGE: Same setpoints, LF at the full rate vs. every 4th sample.
+    FilterManager standard;
+    FilterManager multirate;
+    standard.begin(testFaultHandler, "test_standard");
+    multirate.begin(testFaultHandler, "test_multirate");
+    standard.configure(FilterPipelineConfig::standard(standard.getParams(0), standard.getParams(1)));
+    multirate.configure(FilterPipelineConfig::multirate(standard.getParams(0), standard.getParams(1), 4));
+    randomSeed(5);
+
+    // ACT: A slow drift with noise, long enough for the LF stage to settle.
+    sample_t a = 0, b = 0;
+    double maxDiff = 0.0;
+    for (int i = 0; i < 20000; ++i) {
+        sample_t sample = 150.0 + i * 0.0005 + random(-50, 50) / 100.0;
+        a = standard.process(sample);
+        b = multirate.process(sample);
+        if (i > 5000) maxDiff = std::max(maxDiff, (double)std::fabs(a - b));
+    }
+
+    // ASSERT: The LF stage runs on rescaled setpoints, and the outputs agree
+    // to well within the 0.5 mV noise.
+    FilterParams lf = multirate.getParams(1);
+    TEST_ASSERT_EQUAL(3, multirate.getStageCount());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.0 - std::pow(1.0 - lf.lockSmoothing, 4), multirate.getFilter(1)->params.lockSmoothing);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, lf.trackAssist * 4, multirate.getFilter(1)->params.trackAssist);
+    TEST_ASSERT_EQUAL(3, multirate.getFilter(1)->params.medianWindowSize);
+    TEST_ASSERT_TRUE(maxDiff < 0.25);
+}
+
+/**
+ * @brief Test Case 9: One bank pass matches filtering each channel on its own.
+ */
+void test_filter_bank_pass_matches_single() {
+    // ARRANGE: Two channels stepped one at a time, two through the bank pass.
+    // The second pair runs a 7-sample HF median and a decimated LF stage.
+    FilterManager singleA, singleB, bankA, bankB;
+    singleA.begin(testFaultHandler, "test_single_a");
+    singleB.begin(testFaultHandler, "test_single_b");
+    bankA.begin(testFaultHandler, "test_bank_a");
+    bankB.begin(testFaultHandler, "test_bank_b");
+    FilterParams hf = singleB.getParams(0);
+    hf.medianWindowSize = 7;
+    FilterPipelineConfig mixed = FilterPipelineConfig::multirate(hf, singleB.getParams(1), 2);
+    singleB.configure(mixed);
+    bankB.configure(mixed);
+    uint32_t mask = bankA.getChannelMask() | bankB.getChannelMask();
+    randomSeed(13);
+
+    // ACT & ASSERT: Identical outputs on every sample, including a NaN.
+    sample_t in[FILTER_BANK_CHANNELS] = {0};
+    sample_t out[FILTER_BANK_CHANNELS] = {0};
+    for (int i = 0; i < 300; ++i) {
+        sample_t a = 1500.0 + random(-100, 100) / 10.0 + ((i % 17 == 0) ? 80.0 : 0.0);
+        sample_t b = (i == 150) ? (sample_t)NAN : (sample_t)(20.0 + random(-50, 50) / 100.0);
+        in[bankA.getChannel()] = a;
+        in[bankB.getChannel()] = b;
+        FilterBank::instance().process(in, out, mask);
+        TEST_ASSERT_EQUAL_DOUBLE(singleA.process(a), out[bankA.getChannel()]);
+        TEST_ASSERT_EQUAL_DOUBLE(singleB.process(b), out[bankB.getChannel()]);
+    }
+    TEST_ASSERT_EQUAL(singleA.getNoiseReductionPercentage(), bankA.getNoiseReductionPercentage());
+    TEST_ASSERT_EQUAL(3, bankB.getStageCount());
+}
+
+/**
+ * @brief Test Case 10: A saved state warm-starts a fresh filter, unless stale.
+ */
+void test_filter_manager_warm_start() {
+    // ARRANGE: A settled filter's state, saved at t = 1000 s.
+    FilterManager settled;
+    settled.begin(testFaultHandler, "test_settled");
+    randomSeed(17);
+    for (int i = 0; i < 2000; ++i) settled.process(150.0 + random(-20, 20) / 100.0);
+    FilterStateBlob blob;
+    settled.saveState(blob, 1000);
+    TEST_ASSERT_EQUAL(2, blob.piCount);
+
+    // ACT & ASSERT: A state that is too old, saved after 'now', or far from
+    // the probe, is refused.
+    FilterManager fresh;
+    fresh.begin(testFaultHandler, "test_fresh");
+    TEST_ASSERT_FALSE(fresh.restoreState(blob, 1000 + FILTER_STATE_MAX_AGE_S + 1, 150.0));
+    TEST_ASSERT_FALSE(fresh.restoreState(blob, 999, 150.0));
+    TEST_ASSERT_FALSE(fresh.restoreState(blob, 1060, 150.0 + 2 * FILTER_STATE_MAX_JUMP_MV));
+
+    // ACT: A fresh state is restored.
+    TEST_ASSERT_TRUE(fresh.restoreState(blob, 1060, 150.1));
+
+    // ASSERT: The first output matches the filter that never stopped, instead
+    // of climbing from zero.
+    sample_t expected = settled.process(150.1);
+    sample_t warm = fresh.process(150.1);
+    TEST_ASSERT_DOUBLE_WITHIN(0.001, expected, warm);
+}
+
+/**
+ * @brief Test Case 11: A burst primes the pipeline at the signal level.
+ */
+void test_filter_manager_prime() {
+    // ARRANGE: A 32-sample burst around 150 mV with a spike and a NaN.
+    FilterManager filterManager;
+    filterManager.begin(testFaultHandler, "test_prime");
+    sample_t burst[32];
+    randomSeed(19);
+    for (int i = 0; i < 32; ++i) burst[i] = 150.0 + random(-20, 20) / 100.0;
+    burst[5] = 400.0;
+    burst[9] = NAN;
+
+    // ACT
+    filterManager.prime(burst, 32);
+    sample_t first = filterManager.process(150.0);
+
+    // ASSERT: The first reading is already at the level, and the histories
+    // hold the burst.
+    TEST_ASSERT_DOUBLE_WITHIN(0.3, 150.0, first);
+    TEST_ASSERT_EQUAL(32, filterManager.getFilter(0)->historySize());
+    TEST_ASSERT_TRUE(filterManager.getFilter(0)->getRawStandardDeviation() > 0.0);
+}
+
+/**
+ * @brief Test Case 12: A Hampel stage passes clean samples through unchanged
+ * and replaces only a spike, with the window median.
+ */
+void test_filter_manager_hampel_stage() {
+    // ARRANGE: The Hampel stage alone, so its output is visible.
+    FilterManager filterManager;
+    filterManager.begin(testFaultHandler, "test_hampel");
+    FilterPipelineConfig config;
+    FilterStageConfig hampel;
+    hampel.type = FilterStageType::HAMPEL;
+    hampel.size = 5;
+    config.add(hampel);
+    TEST_ASSERT_TRUE(filterManager.configure(config));
+    const sample_t inputs[8] = {10.0, 10.2, 9.9, 10.1, 9.8, 60.0, 10.0, 10.3};
+    sample_t outputs[8];
+
+    // ACT
+    for (int i = 0; i < 8; ++i) outputs[i] = filterManager.process(inputs[i]);
+
+    // ASSERT: The spike is replaced by the median of {10.2, 9.9, 10.1, 9.8, 60}.
+    TEST_ASSERT_EQUAL(FilterStageType::HAMPEL, filterManager.getStage(0)->getType());
+    for (int i = 0; i < 8; ++i) {
+        if (i == 5) continue;
+        TEST_ASSERT_EQUAL_DOUBLE(inputs[i], outputs[i]);
+    }
+    TEST_ASSERT_EQUAL_DOUBLE(inputs[3], outputs[5]);
+
+    // ACT: The HF stage swapped for a Hampel stage, which takes its role.
+    TEST_ASSERT_TRUE(filterManager.configure(FilterPipelineConfig::hampel(7, 3.0f, filterManager.getParams(0))));
+    filterManager.process(10.0);
+
+    // ASSERT: The PI stage behind it is still LF.
+    TEST_ASSERT_EQUAL(2, filterManager.getStageCount());
+    TEST_ASSERT_NULL(filterManager.getFilter(0));
+    TEST_ASSERT_NOT_NULL(filterManager.getFilter(1));
+}
+
+/**
+ * @brief Test Case 13: A Kalman LF stage can be selected, takes published
+ * setpoints without a rebuild, and drives the noise KPI.
+ */
+void test_filter_manager_kalman_stage() {
+    // ARRANGE
+    FilterManager filterManager;
+    filterManager.begin(testFaultHandler, "test_kalman");
+    KalmanParams kalman;
+    kalman.measurementNoise = 0.25;
+    TEST_ASSERT_TRUE(filterManager.configure(FilterPipelineConfig::kalman(filterManager.getParams(0), kalman)));
+    randomSeed(23);
+
+    // ACT
+    sample_t output = 0.0;
+    for (int i = 0; i < 2000; ++i) output = filterManager.process(150.0 + random(-50, 50) / 100.0);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(2, filterManager.getStageCount());
+    TEST_ASSERT_EQUAL(FilterStageType::KALMAN, filterManager.getStage(1)->getType());
+    KalmanFilter* filter = filterManager.getKalmanFilter();
+    TEST_ASSERT_NOT_NULL(filter);
+    TEST_ASSERT_NULL(filterManager.getFilter(1));
+    TEST_ASSERT_FLOAT_WITHIN(0.2, 150.0, output);
+    TEST_ASSERT_TRUE(filterManager.getNoiseReductionPercentage() > 50);
+
+    // ACT: New setpoints keep the stage and its estimate.
+    kalman.processNoise = 1e-4;
+    filterManager.publishKalmanParams(kalman);
+    filterManager.process(150.0);
+
+    // ASSERT
+    TEST_ASSERT_TRUE(filter == filterManager.getKalmanFilter());
+    TEST_ASSERT_EQUAL_DOUBLE(kalman.processNoise, filter->params.processNoise);
+    TEST_ASSERT_FLOAT_WITHIN(0.2, 150.0, filter->getFilteredValue());
+}
+
+/**
+ * @brief Test Case 14: The mains notch goes in front of the pipeline,
+ * retunes in place, and comes out again, leaving the PI stages indexed as
+ * before.
+ */
+void test_filter_manager_mains_notch() {
+    // ARRANGE
+    FilterManager filterManager;
+    filterManager.begin(testFaultHandler, "test_notch");
+    size_t stageCount = filterManager.getStageCount();
+
+    // ACT
+    TEST_ASSERT_TRUE(filterManager.setMainsNotch(50));
+    filterManager.process(150.0);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(stageCount + 1, filterManager.getStageCount());
+    TEST_ASSERT_EQUAL(FilterStageType::NOTCH, filterManager.getStage(0)->getType());
+    TEST_ASSERT_EQUAL(FilterStageType::PI, filterManager.getStage(1)->getType());
+    TEST_ASSERT_NOT_NULL(filterManager.getFilter(1));
+
+    // ACT: 60 Hz only retunes the notch; the stages keep their state.
+    TEST_ASSERT_TRUE(filterManager.setMainsNotch(60));
+    filterManager.process(150.0);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(stageCount + 1, filterManager.getStageCount());
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 60.0 - 1000.0 / 22.0, filterManager.getConfig().stages[0].notch.frequency);
+    TEST_ASSERT_EQUAL(2, filterManager.getFilter(0)->historySize());
+
+    // ACT: No hum.
+    TEST_ASSERT_TRUE(filterManager.setMainsNotch(0));
+    filterManager.process(150.0);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(stageCount, filterManager.getStageCount());
+    TEST_ASSERT_EQUAL(FilterStageType::PI, filterManager.getStage(0)->getType());
+}
+
+/**
+ * @brief Test Case 15: Behind a Hampel stage, HF setpoints go nowhere and
+ * LF setpoints, published directly or by the tuning engine's refinement
+ * step, reach the LF stage.
+ */
+void test_filter_manager_hampel_roles() {
+    // ARRANGE
+    FilterManager filterManager;
+    filterManager.begin(testFaultHandler, "test_hampel_roles");
+    FilterParams lfParams = filterManager.getParams(1);
+    TEST_ASSERT_TRUE(filterManager.configure(FilterPipelineConfig::hampel(5, 3.0f, lfParams)));
+    filterManager.process(10.0);
+    FilterParams hfParams;
+    hfParams.settleThreshold = 7.5;
+
+    // ACT: HF setpoints have no stage to go to.
+    filterManager.publishParams(0, hfParams);
+    filterManager.process(10.0);
+
+    // ASSERT
+    TEST_ASSERT_FALSE(filterManager.hasPIStage(0));
+    TEST_ASSERT_TRUE(filterManager.hasPIStage(1));
+    TEST_ASSERT_TRUE(filterManager.getFilter(1)->params == lfParams);
+    TEST_ASSERT_TRUE(filterManager.getConfig().stages[1].params == lfParams);
+
+    // ACT: LF setpoints, by index.
+    lfParams.settleThreshold = 12.0;
+    filterManager.publishParams(1, lfParams);
+    filterManager.process(10.0);
+
+    // ASSERT
+    TEST_ASSERT_TRUE(filterManager.getFilter(1)->params == lfParams);
+
+    // ACT: The tuning engine's refinement of both roles.
+    FilterParams ideal = lfParams;
+    ideal.settleThreshold = 22.0;
+    FilterParams refined;
+    bool hfRefined = refineStageParams(filterManager, 0, hfParams, refined);
+    bool lfRefined = refineStageParams(filterManager, 1, ideal, refined);
+    filterManager.process(10.0);
+
+    // ASSERT: Only LF moved, a learning-rate step towards the ideal.
+    TEST_ASSERT_FALSE(hfRefined);
+    TEST_ASSERT_TRUE(lfRefined);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 12.0 + 10.0 * TUNING_LEARNING_RATE, filterManager.getFilter(1)->params.settleThreshold);
+    TEST_ASSERT_EQUAL(2, filterManager.getStageCount());
+    TEST_ASSERT_EQUAL(FilterStageType::HAMPEL, filterManager.getStage(0)->getType());
+
+    // ASSERT: Saved files name the LF stage's setpoints as LF.
+    TEST_ASSERT_NULL(filterManager.getConfig().piStage(0));
+    TEST_ASSERT_TRUE(filterManager.getConfig().piStage(1)->params == filterManager.getParams(1));
+}
+
+/**
+ * @brief Test Case 16: The fixed-point path takes over a prime and a warm
+ * start, and reports its output and graphs like the floating-point one.
+ */
+void test_filter_manager_fixed_point_path() {
+    // ARRANGE: 0.25 mV per count, so 600 counts is 150 mV.
+    const float mvPerCount = 0.25f;
+    sample_t burst[32];
+    for (int i = 0; i < 32; ++i) burst[i] = 150.0 + (i % 3 - 1) * 0.1;
+    FilterManager primed;
+    primed.begin(testFaultHandler, "test_fixed_prime");
+    primed.configure(FilterPipelineConfig::standard(primed.getParams(0), primed.getParams(1)));
+    TEST_ASSERT_NULL(primed.getSnapshot());
+
+    // ACT
+    primed.prime(burst, 32);
+    sample_t first = primed.processCounts(600, mvPerCount);
+
+    // ASSERT: It starts at the burst level instead of climbing from zero,
+    // and the snapshot the reader asked for is the fixed-point one.
+    TEST_ASSERT_DOUBLE_WITHIN(0.5, 150.0, first);
+    const FilterSnapshot* snapshot = primed.getSnapshot();
+    TEST_ASSERT_NOT_NULL(snapshot);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, first, snapshot->filteredValue);
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, 150.0, snapshot->hfRaw[FILTER_HISTORY_SIZE - 1]);
+
+    // ACT: Save the fixed-point state and warm-start another channel from it.
+    for (int i = 0; i < 200; ++i) primed.processCounts(600 + (i % 3 - 1), mvPerCount);
+    FilterStateBlob blob;
+    primed.saveState(blob, 1000);
+    FilterManager warm;
+    warm.begin(testFaultHandler, "test_fixed_warm");
+    warm.configure(FilterPipelineConfig::standard(warm.getParams(0), warm.getParams(1)));
+    bool restored = warm.restoreState(blob, 1060, 150.0);
+    sample_t expected = primed.processCounts(600, mvPerCount);
+    sample_t actual = warm.processCounts(600, mvPerCount);
+
+    // ASSERT
+    TEST_ASSERT_TRUE(restored);
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, expected, actual);
+
+    // ACT: A pipeline without a fixed-point twin falls back to floating point.
+    FilterManager hampel;
+    hampel.begin(testFaultHandler, "test_fixed_fallback");
+    hampel.configure(FilterPipelineConfig::hampel(5, HAMPEL_DEFAULT_THRESHOLD, FilterParams()));
+    FilterManager reference;
+    reference.begin(testFaultHandler, "test_fixed_reference");
+    reference.configure(FilterPipelineConfig::hampel(5, HAMPEL_DEFAULT_THRESHOLD, FilterParams()));
+
+    // ASSERT
+    for (int i = 0; i < 50; ++i) {
+        TEST_ASSERT_TRUE(reference.process(600 * mvPerCount) == hampel.processCounts(600, mvPerCount));
+    }
+}
 
 // --- TEST RUNNER ---
 void setup() {
@@ -82,6 +590,20 @@ void setup() {
     UNITY_BEGIN();
     RUN_TEST(test_filter_manager_initialization);
     RUN_TEST(test_filter_manager_pipeline);
+    RUN_TEST(test_filter_manager_batch_matches_single);
+    RUN_TEST(test_filter_manager_publish_params);
+    RUN_TEST(test_filter_manager_snapshot);
+    RUN_TEST(test_filter_manager_configure_pipeline);
+    RUN_TEST(test_filter_manager_decimated_pipeline);
+    RUN_TEST(test_filter_manager_multirate_matches_standard);
+    RUN_TEST(test_filter_bank_pass_matches_single);
+    RUN_TEST(test_filter_manager_warm_start);
+    RUN_TEST(test_filter_manager_prime);
+    RUN_TEST(test_filter_manager_hampel_stage);
+    RUN_TEST(test_filter_manager_kalman_stage);
+    RUN_TEST(test_filter_manager_mains_notch);
+    RUN_TEST(test_filter_manager_hampel_roles);
+    RUN_TEST(test_filter_manager_fixed_point_path);
     UNITY_END();
 }
 
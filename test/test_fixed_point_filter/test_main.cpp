@@ -0,0 +1,96 @@
+// File Path: /test/test_fixed_point_filter/test_main.cpp
+
+#include <Arduino.h>
+#include <unity.h>
+#include <PI_FilterFixed.h>
+#include <vector>
+#include <cmath>
+
+// 4.096 V range with the x2 probe divider, as the AdcManager reports it.
+#define TEST_MV_PER_COUNT (4096.0f / 32768.0f * 2.0f)
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+// Noisy ADC counts around a DC level, with occasional spikes.
+static int16_t testCounts(int i) {
+    int16_t counts = 1200 + random(-6, 7);
+    if (i % 37 == 0) counts += 150;
+    if (i >= 600) counts += 400; // A step half way through
+    return counts;
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: The fixed-point filter tracks the floating-point one.
+ */
+void test_fixed_point_matches_floating_point() {
+    // ARRANGE: Both filters use the same LF-style setpoints.
+    FilterParams params;
+    params.medianWindowSize = 15;
+    params.settleThreshold = 0.5;
+    params.lockSmoothing = 0.005;
+    params.trackResponse = 0.05;
+    params.trackAssist = 0.0001;
+
+    PI_Filter reference;
+    reference.params = params;
+    PI_FilterFixed fixed;
+    fixed.configure(params, TEST_MV_PER_COUNT);
+    randomSeed(11);
+
+    for (int i = 0; i < 1200; ++i) {
+        // ACT
+        int16_t counts = testCounts(i);
+        sample_t expected = reference.process(counts * TEST_MV_PER_COUNT);
+        fixed.process(PI_FilterFixed::fromCounts(counts));
+
+        // ASSERT: Within a tenth of a count of the floating-point result.
+        TEST_ASSERT_FLOAT_WITHIN(0.1f * TEST_MV_PER_COUNT, expected, fixed.getFilteredMilliVolts());
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, reference.getRawStandardDeviation(), fixed.getRawStandardDeviation());
+}
+
+/**
+ * @brief Test Case 2: Integer statistics match a two-pass reference exactly.
+ */
+void test_integer_statistics_exact() {
+    // ARRANGE
+    IntegerRollingStatistics stats;
+    std::vector<int32_t> window;
+    randomSeed(3);
+
+    for (int i = 0; i < 2000; ++i) {
+        // ACT: Full-scale Q8 samples, the largest the filter will see.
+        int32_t sample = PI_FilterFixed::fromCounts(random(-32768, 32768));
+        if (window.size() == FILTER_HISTORY_SIZE) {
+            stats.slide(sample, window.front());
+            window.erase(window.begin());
+        } else {
+            stats.add(sample);
+        }
+        window.push_back(sample);
+    }
+
+    // ASSERT
+    double mean = 0.0;
+    for (int32_t v : window) mean += v;
+    mean /= window.size();
+    double sumSqDiff = 0.0;
+    for (int32_t v : window) sumSqDiff += (v - mean) * (v - mean);
+    double expected = std::sqrt(sumSqDiff / window.size());
+    TEST_ASSERT_FLOAT_WITHIN(expected * 1e-6, expected, stats.getStandardDeviation());
+}
+
+// --- TEST RUNNER ---
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+    RUN_TEST(test_fixed_point_matches_floating_point);
+    RUN_TEST(test_integer_statistics_exact);
+    UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,124 @@
+// File Path: /test/test_kalman_filter/test_main.cpp
+
+#include <Arduino.h>
+#include <unity.h>
+#include <KalmanFilter.h>
+#include <cmath>
+
+// Uniform +/-1 mV noise has a variance of 1/3 mV^2.
+#define NOISE_VARIANCE (1.0 / 3.0)
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+static double noise() {
+    return random(-1000, 1000) / 1000.0;
+}
+
+// Samples until the estimate is within 1 mV of 'target' for good.
+static int samplesToTrack(KalmanFilter& filter, double target, int maxSamples) {
+    int lastOutside = -1;
+    for (int i = 0; i < maxSamples; ++i) {
+        if (std::fabs(filter.process(target + noise()) - target) > 1.0) lastOutside = i;
+    }
+    return lastOutside + 1;
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: On a flat, noisy signal the estimate converges, and
+ * the filter's own variance matches the error it actually has.
+ */
+void test_kalman_flat_signal() {
+    // ARRANGE
+    KalmanFilter filter;
+    filter.params.measurementNoise = NOISE_VARIANCE;
+    filter.reset();
+    randomSeed(3);
+
+    // ACT: Settle, then measure the error.
+    for (int i = 0; i < 2000; ++i) filter.process(412.0 + noise());
+    double sumSq = 0.0;
+    for (int i = 0; i < 2000; ++i) {
+        double error = filter.process(412.0 + noise()) - 412.0;
+        sumSq += error * error;
+    }
+    double rmsError = std::sqrt(sumSq / 2000);
+
+    // ASSERT
+    TEST_ASSERT_FLOAT_WITHIN(0.2, 412.0, filter.getFilteredValue());
+    TEST_ASSERT_FLOAT_WITHIN(0.5 * rmsError, rmsError, filter.getStandardDeviation());
+    TEST_ASSERT_FLOAT_WITHIN(0.1, NOISE_VARIANCE, filter.getInnovationVariance());
+    TEST_ASSERT_TRUE(filter.getNoiseReductionPercentage() > 80);
+    // Nothing is moving, so Q stays at its floor.
+    TEST_ASSERT_EQUAL_DOUBLE(filter.params.processNoise, filter.getProcessNoise());
+}
+
+/**
+ * @brief Test Case 2: After a step the adaptive filter tracks the new level
+ * far sooner than the same filter with Q fixed, then settles again.
+ */
+void test_kalman_step_adapts() {
+    // ARRANGE: The same setpoints, one with adaptation off.
+    KalmanFilter adaptive, fixed;
+    adaptive.params.measurementNoise = NOISE_VARIANCE;
+    fixed.params = adaptive.params;
+    fixed.params.adaptRate = 0.0;
+    adaptive.reset();
+    fixed.reset();
+    randomSeed(5);
+    for (int i = 0; i < 2000; ++i) {
+        adaptive.process(100.0 + noise());
+        fixed.process(100.0 + noise());
+    }
+
+    // ACT: A 50 mV step.
+    int adaptiveSamples = samplesToTrack(adaptive, 150.0, 2000);
+    int fixedSamples = samplesToTrack(fixed, 150.0, 2000);
+
+    // ASSERT
+    TEST_ASSERT_TRUE(adaptiveSamples < 50);
+    TEST_ASSERT_TRUE(fixedSamples > 200);
+    TEST_ASSERT_EQUAL_DOUBLE(adaptive.params.processNoise, adaptive.getProcessNoise());
+    TEST_ASSERT_FLOAT_WITHIN(0.2, 150.0, adaptive.getFilteredValue());
+}
+
+/**
+ * @brief Test Case 3: NaN readings are skipped, seed() starts at a level,
+ * and after reset() the first reading is taken as it is.
+ */
+void test_kalman_nan_seed_and_reset() {
+    // ARRANGE
+    KalmanFilter filter;
+    filter.seed(20.0);
+
+    // ACT
+    sample_t afterNan = filter.process(NAN);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL_DOUBLE(20.0, afterNan);
+    TEST_ASSERT_EQUAL_DOUBLE(filter.params.measurementNoise, filter.getVariance());
+
+    // ACT: Start over.
+    filter.process(30.0);
+    filter.reset();
+    sample_t first = filter.process(-7.5);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL_DOUBLE(-7.5, first);
+    TEST_ASSERT_EQUAL_DOUBLE(-7.5, filter.getFilteredValue());
+}
+
+// --- TEST RUNNER ---
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+    RUN_TEST(test_kalman_flat_signal);
+    RUN_TEST(test_kalman_step_adapts);
+    RUN_TEST(test_kalman_nan_seed_and_reset);
+    UNITY_END();
+}
+
+void loop() {}
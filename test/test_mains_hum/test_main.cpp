@@ -0,0 +1,126 @@
+// File Path: /test/test_mains_hum/test_main.cpp
+
+#include <Arduino.h>
+#include <unity.h>
+#include <HumDetector.h>
+#include <NotchFilter.h>
+#include <cmath>
+
+// The activation burst is paced by the ADC's DRDY at 860 SPS.
+#define BURST_RATE 860.0
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+static double noise(double amplitude) {
+    return amplitude * random(-1000, 1000) / 1000.0;
+}
+
+// A burst at BURST_RATE: a level, hum and noise.
+static void makeBurst(sample_t* burst, double mainsHz, double humAmplitude, double noiseAmplitude) {
+    for (int i = 0; i < HUM_BURST_SAMPLES; ++i) {
+        double t = i / BURST_RATE;
+        burst[i] = 150.0 + humAmplitude * std::sin(2.0 * M_PI * mainsHz * t + 0.3) + noise(noiseAmplitude);
+    }
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: Goertzel measures the amplitude of the tone it is
+ * tuned to and very little of the other mains frequency.
+ */
+void test_goertzel_amplitude() {
+    // ARRANGE
+    sample_t burst[HUM_BURST_SAMPLES];
+    makeBurst(burst, 50.0, 2.0, 0.0);
+
+    // ACT
+    double at50 = HumDetector::goertzelAmplitude(burst, HUM_BURST_SAMPLES, 150.0, 50.0, BURST_RATE);
+    double at60 = HumDetector::goertzelAmplitude(burst, HUM_BURST_SAMPLES, 150.0, 60.0, BURST_RATE);
+
+    // ASSERT
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 2.0, at50);
+    TEST_ASSERT_TRUE(at60 < 0.3);
+}
+
+/**
+ * @brief Test Case 2: Hum is reported at the right frequency, and plain
+ * noise or hum too faint to matter is not reported.
+ */
+void test_hum_detection() {
+    // ARRANGE
+    sample_t burst[HUM_BURST_SAMPLES];
+    randomSeed(3);
+
+    // ACT & ASSERT: 60 Hz hum in some noise.
+    makeBurst(burst, 60.0, 1.0, 0.3);
+    HumReport hum = HumDetector::analyze(burst, HUM_BURST_SAMPLES, BURST_RATE);
+    TEST_ASSERT_EQUAL(60, hum.mainsFrequency);
+    TEST_ASSERT_FLOAT_WITHIN(0.15, 1.0, hum.amplitude60);
+
+    // ACT & ASSERT: Noise only.
+    makeBurst(burst, 50.0, 0.0, 1.0);
+    hum = HumDetector::analyze(burst, HUM_BURST_SAMPLES, BURST_RATE);
+    TEST_ASSERT_FALSE(hum.detected());
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 1.0 / std::sqrt(3.0), hum.noise);
+
+    // ACT & ASSERT: Hum well below the noise.
+    makeBurst(burst, 50.0, 0.15, 1.0);
+    hum = HumDetector::analyze(burst, HUM_BURST_SAMPLES, BURST_RATE);
+    TEST_ASSERT_FALSE(hum.detected());
+
+    // ACT & ASSERT: A burst too slow to resolve the hum.
+    hum = HumDetector::analyze(burst, HUM_BURST_SAMPLES, 100.0);
+    TEST_ASSERT_FALSE(hum.detected());
+}
+
+/**
+ * @brief Test Case 3: At the data task's rate the notch removes the alias
+ * of 50 Hz hum, passes the level at unity gain and starts without ringing.
+ */
+void test_notch_removes_aliased_hum() {
+    // ARRANGE
+    NotchParams params = NotchParams::forMains(50.0);
+    NotchFilter notch;
+    notch.setParams(params);
+
+    // ASSERT: 50 Hz sampled at 1000/22 Hz lands at 50 - 45.45 Hz.
+    TEST_ASSERT_TRUE(params.isValid());
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 50.0 - 1000.0 / 22.0, params.frequency);
+
+    // ACT: A steady level first.
+    double maxStartError = 0.0;
+    for (int i = 0; i < 50; ++i) maxStartError = std::fmax(maxStartError, std::fabs(notch.process(150.0) - 150.0));
+
+    // ACT: Then 2 mV of hum on it.
+    double maxError = 0.0;
+    for (int i = 0; i < 400; ++i) {
+        double t = (50 + i) * 0.022;
+        sample_t out = notch.process(150.0 + 2.0 * std::sin(2.0 * M_PI * 50.0 * t));
+        if (i >= 200) maxError = std::fmax(maxError, std::fabs(out - 150.0));
+    }
+
+    // ASSERT
+    TEST_ASSERT_TRUE(maxStartError < 1e-9);
+    TEST_ASSERT_TRUE(maxError < 0.1);
+
+    // ASSERT: 60 Hz lands elsewhere, and a decimated stage is refolded.
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 60.0 - 1000.0 / 22.0, NotchParams::forMains(60.0).frequency);
+    NotchParams decimated = params.atDecimatedRate(4);
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 1000.0 / 88.0, decimated.sampleRate);
+    TEST_ASSERT_TRUE(decimated.frequency <= decimated.sampleRate / 2.0);
+}
+
+// --- TEST RUNNER ---
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+    RUN_TEST(test_goertzel_amplitude);
+    RUN_TEST(test_hum_detection);
+    RUN_TEST(test_notch_removes_aliased_hum);
+    UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,196 @@
+// File Path: /test/test_native_conversion_scheduler/test_main.cpp
+// Host-side test against a simulated SPI bus: run with `pio test -e native`.
+
+#include <unity.h>
+#include <ConversionScheduler.h>
+#include <string>
+
+// 860 SPS, in microseconds of simulated time.
+#define CONVERSION_US 1163
+#define FRAME_US 20
+
+/**
+ * @class MockBus
+ * @brief Two simulated ADS1118s on one bus, with a clock that only moves
+ * while the scheduler waits or clocks a frame. Logs every bus operation and
+ * counts breaches of chip-select discipline.
+ */
+class MockBus : public ConversionBus {
+public:
+    std::string log;
+    int violations = 0;
+    uint32_t now = 0;
+    bool dead[SCHED_MAX_CHIPS] = {false, false};
+    uint16_t config[SCHED_MAX_CHIPS] = {0, 0};
+    // A config change the chip acts on only when its conversion ends, as a
+    // chip in continuous mode does.
+    bool continuous[SCHED_MAX_CHIPS] = {false, false};
+
+    void select(uint8_t chip) override {
+        if (_selected >= 0) violations++;
+        _selected = chip;
+        log += "S" + std::to_string(chip) + " ";
+    }
+    void deselect(uint8_t chip) override {
+        if (_selected != chip) violations++;
+        _selected = -1;
+    }
+    bool waitReady(uint8_t chip) override {
+        if (_selected != chip) violations++;
+        if (dead[chip] || !_converting[chip]) return false;
+        if (_doneAt[chip] > now) now = _doneAt[chip];
+        _converting[chip] = false;
+        _result[chip] = _pendingResult[chip];
+        return true;
+    }
+    uint32_t exchange(uint8_t chip, uint16_t word) override {
+        if (_selected != chip) violations++;
+        // A result is only read once its conversion has finished.
+        if (_converting[chip] && !continuous[chip]) violations++;
+        now += FRAME_US;
+        log += "X" + std::to_string(chip) + " ";
+        uint32_t frame = ((uint32_t)(uint16_t)_result[chip] << 16);
+        if (word & SCHED_CFG_VALID) {
+            config[chip] = word;
+            if (continuous[chip]) {
+                // The conversion under way finishes with the old input.
+                continuous[chip] = false;
+                return frame | word;
+            }
+            if (word & SCHED_CFG_START) startConversion(chip, word);
+        }
+        return frame | config[chip];
+    }
+    uint16_t writtenConfig(uint8_t chip) override { return config[chip]; }
+    bool converting(uint8_t chip) const { return _converting[chip]; }
+
+    // What a simulated chip reads on a given config: the chip and mux.
+    static int16_t valueFor(uint8_t chip, uint16_t word) {
+        return (int16_t)(1000 * (chip + 1) + ((word >> 12) & 7));
+    }
+
+    void startContinuous(uint8_t chip, uint16_t word) {
+        continuous[chip] = true;
+        config[chip] = word;
+        startConversion(chip, 0x7000);
+    }
+
+private:
+    void startConversion(uint8_t chip, uint16_t word) {
+        _converting[chip] = true;
+        _doneAt[chip] = now + CONVERSION_US;
+        _pendingResult[chip] = valueFor(chip, word);
+    }
+
+    int _selected = -1;
+    bool _converting[SCHED_MAX_CHIPS] = {false, false};
+    uint32_t _doneAt[SCHED_MAX_CHIPS] = {0, 0};
+    int16_t _pendingResult[SCHED_MAX_CHIPS] = {0, 0};
+    int16_t _result[SCHED_MAX_CHIPS] = {0, 0};
+};
+
+// The ADS1118 config for an input, as AdcManager builds it: 4.096 V range,
+// 860 SPS, pull-up on, single-shot mode.
+static uint16_t configFor(uint8_t mux) {
+    return (uint16_t)((mux << 12) | (0b001 << 9) | (0b111 << 5) | 0x0008 | SCHED_CFG_SINGLE_SHOT | SCHED_CFG_VALID | 0x0001);
+}
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: Both probes and both rails come back in their slots,
+ * the chips take turns on the bus, and the whole set costs two conversion
+ * times rather than four.
+ */
+void test_scheduler_interleaves_chips() {
+    // ARRANGE: Probe (DIFF_0_1) then rail (AIN_2) on each chip; both chips
+    // already in single-shot mode.
+    MockBus bus;
+    bus.config[0] = bus.config[1] = configFor(0);
+    ConversionScheduler scheduler(bus);
+    const ConversionSlot slots[4] = {{0, configFor(0)}, {1, configFor(0)}, {0, configFor(6)}, {1, configFor(6)}};
+    int16_t counts[4];
+    bool ok[4];
+
+    // ACT
+    size_t good = scheduler.run(slots, 4, counts, ok);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(4, good);
+    for (int i = 0; i < 4; ++i) {
+        TEST_ASSERT_TRUE(ok[i]);
+        TEST_ASSERT_EQUAL(MockBus::valueFor(slots[i].chip, slots[i].config), counts[i]);
+    }
+    // Start both, then read-and-start each in turn.
+    TEST_ASSERT_EQUAL_STRING("S0 X0 S1 X1 S0 X0 S1 X1 S0 X0 S1 X1 ", bus.log.c_str());
+    TEST_ASSERT_EQUAL(0, bus.violations);
+    TEST_ASSERT_TRUE(bus.now < 2 * CONVERSION_US + 8 * FRAME_US);
+    // Both chips are left idle: the last frames start nothing.
+    TEST_ASSERT_FALSE(bus.converting(0));
+    TEST_ASSERT_FALSE(bus.converting(1));
+}
+
+/**
+ * @brief Test Case 2: A chip left in continuous mode is switched over
+ * first, and the conversion it had under way is not passed off as a
+ * result.
+ */
+void test_scheduler_leaves_continuous_mode() {
+    // ARRANGE: Chip 0 free-running on AIN_3, chip 1 idle.
+    MockBus bus;
+    bus.startContinuous(0, configFor(7) & ~SCHED_CFG_SINGLE_SHOT);
+    bus.config[1] = configFor(0);
+    ConversionScheduler scheduler(bus);
+    const ConversionSlot slots[2] = {{0, configFor(0)}, {1, configFor(0)}};
+    int16_t counts[2];
+    bool ok[2];
+
+    // ACT
+    size_t good = scheduler.run(slots, 2, counts, ok);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(2, good);
+    TEST_ASSERT_EQUAL(MockBus::valueFor(0, configFor(0)), counts[0]);
+    TEST_ASSERT_EQUAL(MockBus::valueFor(1, configFor(0)), counts[1]);
+    TEST_ASSERT_EQUAL(0, bus.violations);
+}
+
+/**
+ * @brief Test Case 3: A chip that never answers fails its own slots and
+ * does not hold up the other.
+ */
+void test_scheduler_isolates_dead_chip() {
+    // ARRANGE
+    MockBus bus;
+    bus.config[0] = bus.config[1] = configFor(0);
+    bus.dead[1] = true;
+    ConversionScheduler scheduler(bus);
+    const ConversionSlot slots[4] = {{0, configFor(0)}, {1, configFor(0)}, {0, configFor(6)}, {1, configFor(6)}};
+    int16_t counts[4];
+    bool ok[4];
+
+    // ACT
+    size_t good = scheduler.run(slots, 4, counts, ok);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(2, good);
+    TEST_ASSERT_TRUE(ok[0]);
+    TEST_ASSERT_TRUE(ok[2]);
+    TEST_ASSERT_FALSE(ok[1]);
+    TEST_ASSERT_FALSE(ok[3]);
+    TEST_ASSERT_EQUAL(MockBus::valueFor(0, configFor(6)), counts[2]);
+    TEST_ASSERT_EQUAL(0, bus.violations);
+}
+
+// --- TEST RUNNER ---
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_scheduler_interleaves_chips);
+    RUN_TEST(test_scheduler_leaves_continuous_mode);
+    RUN_TEST(test_scheduler_isolates_dead_chip);
+    return UNITY_END();
+}
@@ -0,0 +1,230 @@
+// File Path: /test/test_native_filter_benchmark/test_main.cpp
+// Host-side benchmark: run with `pio test -e native`.
+
+#include <unity.h>
+#include <PI_Filter.h>
+#include <HampelFilter.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define BENCH_SAMPLES 200000
+#define BENCH_REPEATS 5
+
+static std::vector<sample_t> g_signal;
+// A capture-like trace: the probe's true voltage, the same with noise, and
+// that again with spikes.
+static std::vector<sample_t> g_truth;
+static std::vector<sample_t> g_clean;
+static std::vector<sample_t> g_spiky;
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+// A noisy probe-like signal with occasional spikes.
+static void buildSignal() {
+    srand(42);
+    g_signal.resize(BENCH_SAMPLES);
+    for (size_t i = 0; i < g_signal.size(); ++i) {
+        sample_t noise = (rand() % 2001 - 1000) / 250.0f;
+        g_signal[i] = 150.0f + noise + ((i % 53 == 0) ? 40.0f : 0.0f);
+    }
+}
+
+// A probe moved between two buffers every 20 s (tau 5 s), with +/-0.5 mV
+// of noise and a 10 to 60 mV spike, either way, about every 2 s. One spike
+// in five lasts two samples.
+static void buildSpikySignal() {
+    srand(7);
+    g_truth.resize(BENCH_SAMPLES);
+    g_clean.resize(BENCH_SAMPLES);
+    for (size_t i = 0; i < g_truth.size(); ++i) {
+        size_t leg = i / 910;
+        double target = (leg % 2) ? 177.0 : 0.0;
+        double start = (leg == 0) ? 0.0 : 177.0 - target;
+        g_truth[i] = (sample_t)(target + (start - target) * std::exp(-(double)(i % 910) * 0.022 / 5.0));
+        g_clean[i] = g_truth[i] + (sample_t)((rand() % 2001 - 1000) / 2000.0);
+    }
+    g_spiky = g_clean;
+    for (size_t i = 0; i + 1 < g_spiky.size(); ++i) {
+        if (rand() % 90 != 0) continue;
+        sample_t spike = (sample_t)((rand() % 2 ? 1 : -1) * (10 + rand() % 51));
+        g_spiky[i] += spike;
+        if (rand() % 5 == 0) g_spiky[++i] += spike;
+    }
+}
+
+static void setStageParams(FilterParams& params, int medianWindowSize) {
+    params.medianWindowSize = medianWindowSize;
+    params.settleThreshold = 0.5;
+    params.lockSmoothing = 0.02;
+    params.trackResponse = 0.6;
+    params.trackAssist = 0.01;
+}
+
+// Best-of-N nanoseconds per sample for a freshly constructed filter.
+template <typename Filter>
+static double nsPerSample(int medianWindowSize) {
+    double best = 1e9;
+    for (int r = 0; r < BENCH_REPEATS; ++r) {
+        Filter filter;
+        setStageParams(filter.params, medianWindowSize);
+        volatile sample_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (sample_t x : g_signal) sink = filter.process(x);
+        auto end = std::chrono::steady_clock::now();
+        (void)sink;
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / g_signal.size();
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+template <int MedianN>
+static void benchmarkShape(const char* stage) {
+    double generic = nsPerSample<PI_Filter>(MedianN);
+    double specialised = nsPerSample<PI_FilterT<MedianN, FILTER_HISTORY_SIZE, sample_t> >(MedianN);
+    printf("  %s median %2d: generic %6.1f ns/sample, specialised %6.1f ns/sample (%.2fx)\n",
+           stage, MedianN, generic, specialised, generic / specialised);
+}
+
+static double rmsError(const std::vector<sample_t>& out, const std::vector<sample_t>& reference) {
+    double sum = 0.0;
+    for (size_t i = 0; i < out.size(); ++i) sum += (out[i] - reference[i]) * (out[i] - reference[i]);
+    return std::sqrt(sum / out.size());
+}
+
+// Best-of-N nanoseconds per sample of a spike scraper over the spiky trace,
+// and its output.
+template <typename Scraper>
+static double scrape(Scraper& scraper, std::vector<sample_t>& out) {
+    out.resize(g_spiky.size());
+    double best = 1e9;
+    for (int r = 0; r < BENCH_REPEATS; ++r) {
+        scraper.reset();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < g_spiky.size(); ++i) out[i] = scraper.process(g_spiky[i]);
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / g_spiky.size();
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+// The default HF stage (see FilterManager::begin).
+struct HFScraper {
+    PI_FilterT<5, FILTER_HISTORY_SIZE, sample_t> filter;
+    HFScraper() {
+        setStageParams(filter.params, 5);
+        filter.params.settleThreshold = 0.1;
+        filter.params.lockSmoothing = 0.1;
+    }
+    void reset() { filter.reset(); }
+    sample_t process(sample_t x) { return filter.process(x); }
+};
+
+// The Hampel stage, with the network for its window (see HampelStage).
+template <int N>
+struct HampelScraper {
+    HampelFilter filter;
+    HampelScraper() { filter.setWindowSize(N); }
+    void reset() { filter.clear(); }
+    sample_t process(sample_t x) { return filter.processWindow<N>(x); }
+};
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: Specialised stages are bit-identical to the generic filter.
+ */
+template <int MedianN>
+static void assertMatchesGeneric() {
+    // ARRANGE
+    PI_Filter generic;
+    PI_FilterT<MedianN, FILTER_HISTORY_SIZE, sample_t> specialised;
+    setStageParams(generic.params, MedianN);
+    setStageParams(specialised.params, MedianN);
+
+    for (size_t i = 0; i < 5000; ++i) {
+        // ACT
+        sample_t expected = generic.process(g_signal[i]);
+        sample_t actual = specialised.process(g_signal[i]);
+
+        // ASSERT
+        TEST_ASSERT_TRUE(expected == actual);
+        TEST_ASSERT_EQUAL(generic.getStabilityPercentage(), specialised.getStabilityPercentage());
+    }
+}
+
+void test_specialised_matches_generic() {
+    assertMatchesGeneric<5>();
+    assertMatchesGeneric<7>();
+    assertMatchesGeneric<15>();
+}
+
+/**
+ * @brief Test Case 2: Reports per-sample cost of the HF stage shapes. Only
+ * the network windows are specialised; a fixed LF window of 15 keeps the
+ * StreamingMedian and measured no faster than the generic filter.
+ */
+void test_benchmark_stage_shapes() {
+    benchmarkShape<5>("HF");
+    benchmarkShape<7>("HF");
+}
+
+/**
+ * @brief Test Case 3: A Hampel stage against the HF stage as the spike
+ * scraper in front of LF. Reports CPU per sample, the noise reduction
+ * against the true voltage, and how far the output strays from the noisy
+ * but spike-free trace: the detail taken out of the signal, plus any spike
+ * left in it.
+ */
+void test_benchmark_hampel_vs_hf() {
+    // ARRANGE
+    HFScraper hf;
+    HampelScraper<5> hampel5;
+    HampelScraper<7> hampel7;
+    std::vector<sample_t> out[3];
+    double ns[3];
+    const char* names[3] = { "HF PI, median 5", "Hampel 5", "Hampel 7" };
+
+    // ACT
+    ns[0] = scrape(hf, out[0]);
+    ns[1] = scrape(hampel5, out[1]);
+    ns[2] = scrape(hampel7, out[2]);
+
+    // ASSERT
+    double inputNoise = rmsError(g_spiky, g_truth);
+    double altered[3];
+    printf("  input: %.2f mV RMS from the true voltage\n", inputNoise);
+    for (int k = 0; k < 3; ++k) {
+        double noise = rmsError(out[k], g_truth);
+        altered[k] = rmsError(out[k], g_clean);
+        printf("  %-16s %6.1f ns/sample, noise reduction %5.1f%%, %.3f mV RMS from the spike-free trace\n",
+               names[k], ns[k], 100.0 * (1.0 - noise / inputNoise), altered[k]);
+    }
+    // The Hampel stages clear the spikes and otherwise leave the trace alone.
+    TEST_ASSERT_TRUE(altered[1] < altered[0]);
+    TEST_ASSERT_TRUE(altered[2] < altered[0]);
+
+    // The network path matches the StreamingMedian one.
+    HampelFilter runtime;
+    runtime.setWindowSize(5);
+    for (size_t i = 0; i < g_spiky.size(); ++i) {
+        TEST_ASSERT_TRUE(runtime.process(g_spiky[i]) == out[1][i]);
+    }
+}
+
+// --- TEST RUNNER ---
+int main() {
+    buildSignal();
+    buildSpikySignal();
+    UNITY_BEGIN();
+    RUN_TEST(test_specialised_matches_generic);
+    RUN_TEST(test_benchmark_stage_shapes);
+    RUN_TEST(test_benchmark_hampel_vs_hf);
+    return UNITY_END();
+}
@@ -0,0 +1,111 @@
+// File Path: /test/test_native_scan_list/test_main.cpp
+// Host-side test: run with `pio test -e native`.
+
+#include <unity.h>
+#include <ScanList.h>
+
+// ADS1118 field values, as ADS1118.h defines them.
+#define MUX_DIFF_0_1 0b000
+#define MUX_AIN_2    0b110
+#define PGA_4096     0b001
+#define PGA_0256     0b111
+#define DR_860SPS    0b111
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: A channel's word carries its mux, range, rate and
+ * sensor mode, in single-shot mode with the pull-up on and the write
+ * flagged valid, and without the start bit.
+ */
+void test_config_word_layout() {
+    // ARRANGE
+    ScanChannel probe = {0, MUX_DIFF_0_1, PGA_4096, DR_860SPS, false};
+    ScanChannel rail = {1, MUX_AIN_2, PGA_4096, DR_860SPS, false};
+    ScanChannel temperature = {1, MUX_DIFF_0_1, PGA_4096, DR_860SPS, true};
+
+    // ACT & ASSERT
+    TEST_ASSERT_EQUAL_HEX16(0x03EB, ScanList::configWord(probe));
+    TEST_ASSERT_EQUAL_HEX16(0x63EB, ScanList::configWord(rail));
+    TEST_ASSERT_EQUAL_HEX16(0x03FB, ScanList::configWord(temperature));
+    TEST_ASSERT_EQUAL_HEX16(0, ScanList::configWord(rail) & SCHED_CFG_START);
+}
+
+/**
+ * @brief Test Case 2: The list hands out channel numbers in order, keeps a
+ * prebuilt slot per channel, and rebuilds only the word whose mux changes.
+ */
+void test_channels_and_slots() {
+    // ARRANGE
+    ScanList scan;
+
+    // ACT
+    int ph = scan.add({0, MUX_DIFF_0_1, PGA_4096, DR_860SPS, false});
+    int ec = scan.add({1, MUX_DIFF_0_1, PGA_4096, DR_860SPS, false});
+    int bad = scan.add({SCHED_MAX_CHIPS, MUX_DIFF_0_1, PGA_4096, DR_860SPS, false});
+    uint16_t ecWord = scan.slots()[ec].config;
+    bool switched = scan.setMux(ph, MUX_AIN_2);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(0, ph);
+    TEST_ASSERT_EQUAL(1, ec);
+    TEST_ASSERT_EQUAL(-1, bad);
+    TEST_ASSERT_EQUAL(2, scan.size());
+    TEST_ASSERT_TRUE(switched);
+    TEST_ASSERT_FALSE(scan.setMux(2, MUX_AIN_2));
+    TEST_ASSERT_EQUAL(1, scan.slots()[ec].chip);
+    TEST_ASSERT_EQUAL_HEX16(ecWord, scan.slots()[ec].config);
+    TEST_ASSERT_EQUAL_HEX16(0x63EB, scan.slots()[ph].config);
+    TEST_ASSERT_EQUAL(MUX_AIN_2, scan.channel(ph).mux);
+}
+
+/**
+ * @brief Test Case 3: The list takes no more than one scheduler run.
+ */
+void test_list_is_bounded() {
+    // ARRANGE
+    ScanList scan;
+    for (int i = 0; i < SCAN_MAX_CHANNELS; ++i) {
+        scan.add({(uint8_t)(i % SCHED_MAX_CHIPS), MUX_AIN_2, PGA_4096, DR_860SPS, false});
+    }
+
+    // ACT
+    int extra = scan.add({0, MUX_AIN_2, PGA_4096, DR_860SPS, false});
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(-1, extra);
+    TEST_ASSERT_EQUAL(SCAN_MAX_CHANNELS, scan.size());
+}
+
+/**
+ * @brief Test Case 4: Counts scale by the channel's own range, and a
+ * temperature channel comes out in degrees Celsius.
+ */
+void test_units_per_count() {
+    // ARRANGE
+    ScanList scan;
+    scan.add({0, MUX_AIN_2, PGA_4096, DR_860SPS, false});
+    scan.add({0, MUX_AIN_2, PGA_0256, DR_860SPS, false});
+    scan.add({1, MUX_DIFF_0_1, PGA_4096, DR_860SPS, true});
+
+    // ACT & ASSERT
+    TEST_ASSERT_EQUAL_DOUBLE(0.125, scan.unitsPerCount(0));
+    TEST_ASSERT_EQUAL_DOUBLE(256.0 / 32768, scan.unitsPerCount(1));
+    // 25 °C is 800 LSBs of the 14-bit result, left-justified.
+    TEST_ASSERT_EQUAL_DOUBLE(25.0, (800 << 2) * scan.unitsPerCount(2));
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, scan.unitsPerCount(3));
+}
+
+// --- TEST RUNNER ---
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_config_word_layout);
+    RUN_TEST(test_channels_and_slots);
+    RUN_TEST(test_list_is_bounded);
+    RUN_TEST(test_units_per_count);
+    return UNITY_END();
+}
@@ -0,0 +1,79 @@
+// File Path: /test/test_rolling_statistics/test_main.cpp
+
+#include <Arduino.h>
+#include <unity.h>
+#include <RollingStatistics.h>
+#include <vector>
+#include <cmath>
+
+#define TEST_WINDOW 32
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+// Reference: the two-pass population std-dev the PI_Filter used to compute.
+static double referenceStdDev(const std::vector<sample_t>& window) {
+    double sum = 0.0;
+    for (double v : window) sum += v;
+    double mean = sum / window.size();
+    double sumSqDiff = 0.0;
+    for (double v : window) sumSqDiff += (v - mean) * (v - mean);
+    return std::sqrt(sumSqDiff / window.size());
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: Sliding statistics track the two-pass reference.
+ */
+void test_rolling_statistics_matches_two_pass() {
+    // ARRANGE: A large DC offset with small noise is the worst case for drift.
+    RollingStatistics stats(TEST_WINDOW);
+    std::vector<sample_t> window;
+    randomSeed(7);
+
+    for (int i = 0; i < 5000; ++i) {
+        // ACT
+        sample_t sample = 1500.0 + random(-100, 100) / 100.0;
+        if ((int)window.size() == TEST_WINDOW) {
+            stats.slide(sample, window.front());
+            window.erase(window.begin());
+        } else {
+            stats.add(sample);
+        }
+        window.push_back(sample);
+
+        // ASSERT
+        if (window.size() >= 2) {
+            TEST_ASSERT_DOUBLE_WITHIN(1e-9, referenceStdDev(window), stats.getStandardDeviation());
+        }
+    }
+}
+
+/**
+ * @brief Test Case 2: A constant signal reports exactly zero deviation.
+ */
+void test_rolling_statistics_constant_signal() {
+    // ARRANGE
+    RollingStatistics stats(TEST_WINDOW);
+    for (int i = 0; i < TEST_WINDOW; ++i) stats.add(3.3);
+
+    // ACT
+    for (int i = 0; i < 1000; ++i) stats.slide(3.3, 3.3);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(TEST_WINDOW, stats.getCount());
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, stats.getStandardDeviation());
+}
+
+// --- TEST RUNNER ---
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+    RUN_TEST(test_rolling_statistics_matches_two_pass);
+    RUN_TEST(test_rolling_statistics_constant_signal);
+    UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,134 @@
+// File Path: /test/test_sample_bus/test_main.cpp
+
+#include <Arduino.h>
+#include <unity.h>
+#include <SampleBus.h>
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+static SampleRecord record(uint32_t sequence) {
+    SampleRecord r;
+    r.timestampUs = sequence * 22000;
+    r.channel = sequence & 1;
+    r.generation = 0;
+    r.rawCount = (int16_t)sequence;
+    return r;
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: Two consumers each see the whole stream, in order and
+ * in place, across many wraps of the ring.
+ */
+void test_sample_bus_consumers_share_stream() {
+    // ARRANGE
+    static SampleBus<8> bus;
+    SampleCursor fast, slow;
+    bus.attach(fast);
+    bus.attach(slow);
+    uint32_t expectedFast = 0, expectedSlow = 0;
+    bool inOrder = true, inPlace = true;
+
+    // ACT: 'fast' reads after every publish, 'slow' after every third.
+    for (uint32_t n = 0; n < 300; ++n) {
+        bus.publish(record(n));
+        const SampleRecord* records;
+        size_t count;
+        while ((count = bus.peek(fast, records)) > 0) {
+            for (size_t i = 0; i < count; ++i) inOrder = inOrder && records[i].rawCount == (int16_t)expectedFast++;
+            bus.consume(fast, count);
+        }
+        if (n % 3 != 2) continue;
+        while ((count = bus.peek(slow, records)) > 0) {
+            const SampleRecord* again;
+            bus.peek(slow, again);
+            inPlace = inPlace && again == records;
+            for (size_t i = 0; i < count; ++i) inOrder = inOrder && records[i].timestampUs == expectedSlow++ * 22000;
+            bus.consume(slow, count);
+        }
+    }
+
+    // ASSERT
+    TEST_ASSERT_TRUE(inOrder);
+    TEST_ASSERT_TRUE(inPlace);
+    TEST_ASSERT_EQUAL(300, expectedFast);
+    TEST_ASSERT_EQUAL(300, expectedSlow);
+    TEST_ASSERT_EQUAL(0, fast.overruns);
+    TEST_ASSERT_EQUAL(0, slow.overruns);
+}
+
+/**
+ * @brief Test Case 2: A consumer that falls behind loses the oldest records,
+ * counted in its own cursor, while the producer carries on and the other
+ * consumer loses nothing.
+ */
+void test_sample_bus_slow_consumer_overrun() {
+    // ARRANGE
+    static SampleBus<16> bus;
+    SampleCursor keeping, lagging;
+    bus.attach(keeping);
+    bus.attach(lagging);
+    SampleRecord out[16];
+    size_t kept = 0;
+
+    // ACT: 40 records; only 'keeping' reads along the way.
+    for (uint32_t n = 0; n < 40; ++n) {
+        bus.publish(record(n));
+        kept += bus.read(keeping, out, 16);
+    }
+    size_t late = bus.read(lagging, out, 16);
+
+    // ASSERT: 'lagging' gets the newest half of the ring.
+    TEST_ASSERT_EQUAL(40, kept);
+    TEST_ASSERT_EQUAL(0, keeping.overruns);
+    TEST_ASSERT_EQUAL(8, late);
+    TEST_ASSERT_EQUAL(32, lagging.overruns);
+    TEST_ASSERT_EQUAL(32, out[0].rawCount);
+    TEST_ASSERT_EQUAL(39, out[7].rawCount);
+    TEST_ASSERT_EQUAL(0, bus.pending(lagging));
+}
+
+/**
+ * @brief Test Case 3: consume() reports records overwritten while they
+ * were peeked, and a cursor attached later starts at the next record.
+ */
+void test_sample_bus_detects_overwrite() {
+    // ARRANGE
+    static SampleBus<8> bus;
+    SampleCursor cursor;
+    bus.attach(cursor);
+    for (uint32_t n = 0; n < 4; ++n) bus.publish(record(n));
+    const SampleRecord* records;
+    size_t count = bus.peek(cursor, records);
+
+    // ACT: The producer laps the peeked records.
+    for (uint32_t n = 4; n < 12; ++n) bus.publish(record(n));
+    bool intact = bus.consume(cursor, count);
+    SampleCursor late;
+    bus.attach(late);
+    bus.publish(record(12));
+    SampleRecord out[8];
+    size_t lateCount = bus.read(late, out, 8);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(4, count);
+    TEST_ASSERT_FALSE(intact);
+    TEST_ASSERT_EQUAL(4, cursor.overruns);
+    TEST_ASSERT_EQUAL(1, lateCount);
+    TEST_ASSERT_EQUAL(12, out[0].rawCount);
+}
+
+// --- TEST RUNNER ---
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+    RUN_TEST(test_sample_bus_consumers_share_stream);
+    RUN_TEST(test_sample_bus_slow_consumer_overrun);
+    RUN_TEST(test_sample_bus_detects_overwrite);
+    UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,131 @@
+// File Path: /test/test_stability_detector/test_main.cpp
+
+#include <Arduino.h>
+#include <unity.h>
+#include <StabilityDetector.h>
+#include <cmath>
+
+#define SAMPLE_PERIOD_S 0.022
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+// +/-0.05 mV of noise, about what is left after the LF stage.
+static double noise() {
+    return random(-100, 100) / 2000.0;
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: A flat, slightly noisy signal is stable once the
+ * window is full, and not before.
+ */
+void test_stability_flat_signal() {
+    // ARRANGE
+    StabilityDetector detector(SAMPLE_PERIOD_S);
+    randomSeed(3);
+
+    // ACT
+    for (int i = 0; i < STABILITY_WINDOW_SIZE - 1; ++i) detector.push(412.0 + noise());
+    bool stableBeforeFull = detector.isStable();
+    detector.push(412.0 + noise());
+
+    // ASSERT
+    TEST_ASSERT_FALSE(stableBeforeFull);
+    TEST_ASSERT_TRUE(detector.isFull());
+    TEST_ASSERT_TRUE(detector.isStable());
+    TEST_ASSERT_EQUAL(100, detector.getStabilityPercentage());
+    TEST_ASSERT_FALSE(detector.sawMovement());
+}
+
+/**
+ * @brief Test Case 2: A slow ramp is measured in mV per minute, and fails
+ * the criteria even though it is far quieter than the noise limit.
+ */
+void test_stability_ramp_is_not_stable() {
+    // ARRANGE: 3 mV/min, three times the default limit.
+    const double slope = 3.0;
+    StabilityDetector detector(SAMPLE_PERIOD_S);
+    randomSeed(5);
+
+    // ACT
+    for (int i = 0; i < 2 * STABILITY_WINDOW_SIZE; ++i) {
+        detector.push(100.0 + slope * i * SAMPLE_PERIOD_S / 60.0 + noise());
+    }
+
+    // ASSERT
+    TEST_ASSERT_FLOAT_WITHIN(0.3, slope, detector.getSlope());
+    TEST_ASSERT_TRUE(detector.getResidualNoise() < STABILITY_MAX_NOISE_MV);
+    TEST_ASSERT_FALSE(detector.isStable());
+    TEST_ASSERT_TRUE(detector.getStabilityPercentage() < 50);
+    TEST_ASSERT_TRUE(detector.sawMovement());
+
+    // ACT: A looser slope limit accepts the same ramp.
+    StabilityCriteria criteria;
+    criteria.maxSlope = 5.0f;
+    detector.setCriteria(criteria);
+
+    // ASSERT
+    TEST_ASSERT_TRUE(detector.isStable());
+}
+
+/**
+ * @brief Test Case 3: After many laps of sliding, the running fit matches a
+ * fit computed from scratch over the same window.
+ */
+void test_stability_matches_direct_fit() {
+    // ARRANGE: A settling electrode, so the slope changes as it slides.
+    StabilityDetector detector(SAMPLE_PERIOD_S);
+    randomSeed(7);
+    const int total = 10 * STABILITY_WINDOW_SIZE + 37;
+    static float samples[10 * STABILITY_WINDOW_SIZE + 37];
+    for (int i = 0; i < total; ++i) {
+        double t = i * SAMPLE_PERIOD_S;
+        samples[i] = (float)(177.0 * (1.0 - std::exp(-t / 20.0)) + noise());
+    }
+
+    // ACT
+    for (int i = 0; i < total; ++i) detector.push(samples[i]);
+
+    // ASSERT: Two-pass least squares over the last window.
+    const int n = STABILITY_WINDOW_SIZE;
+    const float* window = samples + total - n;
+    double meanK = (n - 1) / 2.0, meanY = 0.0;
+    for (int k = 0; k < n; ++k) meanY += window[k];
+    meanY /= n;
+    double ckk = 0.0, cky = 0.0;
+    for (int k = 0; k < n; ++k) {
+        ckk += (k - meanK) * (k - meanK);
+        cky += (k - meanK) * (window[k] - meanY);
+    }
+    double slope = cky / ckk;
+    double sse = 0.0;
+    for (int k = 0; k < n; ++k) {
+        double residual = window[k] - meanY - slope * (k - meanK);
+        sse += residual * residual;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, slope * 60.0 / SAMPLE_PERIOD_S, detector.getSlope());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, std::sqrt(sse / (n - 2)), detector.getResidualNoise());
+
+    // ACT: Start over.
+    detector.reset();
+
+    // ASSERT
+    TEST_ASSERT_FALSE(detector.isFull());
+    TEST_ASSERT_FALSE(detector.sawMovement());
+    TEST_ASSERT_EQUAL(0, detector.getStabilityPercentage());
+}
+
+// --- TEST RUNNER ---
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+    RUN_TEST(test_stability_flat_signal);
+    RUN_TEST(test_stability_ramp_is_not_stable);
+    RUN_TEST(test_stability_matches_direct_fit);
+    UNITY_END();
+}
+
+void loop() {}
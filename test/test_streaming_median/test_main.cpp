@@ -0,0 +1,111 @@
+// File Path: /test/test_streaming_median/test_main.cpp
+
+#include <Arduino.h>
+#include <unity.h>
+#include <StreamingMedian.h>
+#include <vector>
+#include <algorithm>
+
+// --- Test Suite Setup & Teardown ---
+void setUp(void) {}
+void tearDown(void) {}
+
+// Reference median: the element the original copy-and-sort filter returned.
+static sample_t referenceMedian(const std::vector<sample_t>& window) {
+    std::vector<sample_t> sorted = window;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[sorted.size() / 2];
+}
+
+// --- TEST CASES ---
+
+/**
+ * @brief Test Case 1: Sliding window matches the sort-based median exactly.
+ */
+void test_streaming_median_matches_sort() {
+    // ARRANGE
+    StreamingMedian median;
+    median.setWindowSize(15);
+    std::vector<sample_t> window;
+    randomSeed(42);
+
+    for (int i = 0; i < 500; ++i) {
+        // ACT: Feed a noisy signal with occasional spikes and repeated values.
+        sample_t sample = 100.0 + random(-50, 50) / 10.0;
+        if (i % 23 == 0) sample += 40.0;
+        window.push_back(sample);
+        if (window.size() > 15) window.erase(window.begin());
+        sample_t result = median.push(sample);
+
+        // ASSERT
+        TEST_ASSERT_EQUAL_DOUBLE(referenceMedian(window), result);
+    }
+}
+
+/**
+ * @brief Test Case 2: Runtime resizing evicts the oldest samples.
+ */
+void test_streaming_median_resize() {
+    // ARRANGE
+    StreamingMedian median;
+    median.setWindowSize(7);
+    for (int i = 1; i <= 7; ++i) median.push(i * 10.0);
+
+    // ACT: Shrink to the three newest samples (50, 60, 70).
+    median.setWindowSize(3);
+
+    // ASSERT
+    TEST_ASSERT_EQUAL(3, median.size());
+    TEST_ASSERT_EQUAL_DOUBLE(60.0, median.getMedian());
+
+    // ACT: Grow again; the window fills back up before evicting.
+    median.setWindowSize(5);
+    median.push(0.0);
+    median.push(0.0);
+
+    // ASSERT: Window is now {50, 60, 70, 0, 0}.
+    TEST_ASSERT_EQUAL(5, median.size());
+    TEST_ASSERT_EQUAL_DOUBLE(50.0, median.getMedian());
+}
+
+/**
+ * @brief Test Case 3: Resizing mid-run matches the sort-based median of the
+ * newest samples that fit, from the next sample on.
+ */
+void test_streaming_median_resize_mid_run() {
+    // ARRANGE
+    StreamingMedian median;
+    median.setWindowSize(15);
+    std::vector<sample_t> window;
+    const int sizes[] = { 15, 4, 9, 1, 31, 6 };
+    randomSeed(7);
+
+    for (int i = 0; i < 600; ++i) {
+        // ACT: Change the size every 100 samples, shrinking and growing.
+        if (i % 100 == 0) {
+            int size = sizes[i / 100];
+            median.setWindowSize(size);
+            while (window.size() > (size_t)size) window.erase(window.begin());
+            TEST_ASSERT_EQUAL(window.size(), median.size());
+        }
+        sample_t sample = 100.0 + random(-50, 50) / 10.0;
+        window.push_back(sample);
+        if (window.size() > (size_t)median.getWindowSize()) window.erase(window.begin());
+        sample_t result = median.push(sample);
+
+        // ASSERT
+        TEST_ASSERT_EQUAL_DOUBLE(referenceMedian(window), result);
+    }
+}
+
+// --- TEST RUNNER ---
+void setup() {
+    delay(2000);
+    UNITY_BEGIN();
+    RUN_TEST(test_streaming_median_matches_sort);
+    RUN_TEST(test_streaming_median_resize);
+    RUN_TEST(test_streaming_median_resize_mid_run);
+    UNITY_END();
+}
+
+void loop() {}